@@ -20,6 +20,7 @@
 #include <typeinfo>
 #include <boost/mpl/bool.hpp>
 #include <boost/mpl/vector.hpp>
+#include <boost/mpl/vector/vector30.hpp>
 #include <boost/mpl/find.hpp>
 #include <boost/mpl/for_each.hpp>
 #include <boost/python/object.hpp>
@@ -376,18 +377,25 @@ write_graphml(std::ostream& out, const Graph& g, VertexIndexMap vertex_index,
            "         xsi:schemaLocation=\"http://graphml.graphdrawing.org/xmlns"
            " http://graphml.graphdrawing.org/xmlns/1.0/graphml.xsd\">\n\n";
 
-    typedef mpl::vector<bool, uint8_t, int8_t, uint16_t, int16_t, uint32_t,
-                        int32_t, uint64_t, int64_t, float, double, long double,
-                        std::vector<uint8_t>, std::vector<int32_t>,
-                        std::vector<int64_t>, std::vector<double>,
-                        std::vector<long double>, std::vector<std::string>,
-                        std::string, python::object> value_types;
+    // unsigned types are written as the next larger signed type, so that
+    // they are read back without overflow; 64-bit unsigned values have no
+    // such type, and are written as strings
+    typedef mpl::vector23<bool, uint8_t, int8_t, uint16_t, int16_t, uint32_t,
+                          int32_t, uint64_t, int64_t, float, double,
+                          long double, std::vector<uint8_t>,
+                          std::vector<int32_t>, std::vector<int64_t>,
+                          std::vector<double>, std::vector<long double>,
+                          std::vector<std::string>, std::string,
+                          python::object, std::vector<float>,
+                          std::vector<uint32_t>, std::vector<uint64_t>>
+        value_types;
     const char* type_names[] = {"boolean", "boolean", "boolean", "short",
-                                "short", "int", "int", "long", "long", "float",
-                                "float", "double", "vector_boolean",
+                                "short", "long", "int", "string", "long",
+                                "float", "float", "double", "vector_boolean",
                                 "vector_int", "vector_long", "vector_float",
                                 "vector_double", "vector_string", "string",
-                                "python_object"};
+                                "python_object", "vector_float", "vector_long",
+                                "string"};
 
     std::map<std::string, std::string> graph_key_ids;
     std::map<std::string, std::string> vertex_key_ids;
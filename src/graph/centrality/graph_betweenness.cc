@@ -138,7 +138,7 @@ void betweenness(GraphInterface& g, boost::any weight,
 
     if (!weight.empty())
     {
-        run_action<>()
+        run_action_nogil<>()
             (g, std::bind<>(get_weighted_betweenness(),
                             std::placeholders::_1, g.GetVertexIndex(),
                             std::placeholders::_2,
@@ -150,7 +150,7 @@ void betweenness(GraphInterface& g, boost::any weight,
     }
     else
     {
-        run_action<>()
+        run_action_nogil<>()
             (g, std::bind<void>(get_betweenness(), std::placeholders::_1,
                                 g.GetVertexIndex(), std::placeholders::_2,
                                 std::placeholders::_3, normalize,
@@ -175,7 +175,7 @@ double central_point(GraphInterface& g,
                      boost::any vertex_betweenness)
 {
     double c = 0.0;
-    run_action<graph_tool::detail::never_reversed>()
+    run_action_nogil<graph_tool::detail::never_reversed>()
         (g, std::bind<>(get_central_point_dominance(), std::placeholders::_1,
                         std::placeholders::_2, std::ref(c)),
          vertex_scalar_properties()) (vertex_betweenness);
@@ -32,20 +32,20 @@ void do_get_closeness(GraphInterface& gi, boost::any weight,
 {
     if (weight.empty())
     {
-        run_action<>()(gi,
-                       std::bind(get_closeness(), placeholders::_1,
-                                 gi.GetVertexIndex(), no_weightS(),
-                                 placeholders::_2, harmonic, norm),
-                       writable_vertex_scalar_properties())(closeness);
+        run_action_nogil<>()
+            (gi, std::bind(get_closeness(), placeholders::_1,
+                           gi.GetVertexIndex(), no_weightS(),
+                           placeholders::_2, harmonic, norm),
+             writable_vertex_scalar_properties())(closeness);
     }
     else
     {
-        run_action<>()(gi,
-                       std::bind(get_closeness(), placeholders::_1,
-                                 gi.GetVertexIndex(), placeholders::_2,
-                                 placeholders::_3, harmonic, norm),
-                       edge_scalar_properties(),
-                       writable_vertex_scalar_properties())(weight, closeness);
+        run_action_nogil<>()
+            (gi, std::bind(get_closeness(), placeholders::_1,
+                           gi.GetVertexIndex(), placeholders::_2,
+                           placeholders::_3, harmonic, norm),
+             edge_scalar_properties(),
+             writable_vertex_scalar_properties())(weight, closeness);
     }
 }
 
@@ -41,7 +41,7 @@ long double eigenvector(GraphInterface& g, boost::any w, boost::any c,
         w = weight_map_t(1);
 
     long double eig = 0;
-    run_action<>()
+    run_action_nogil<>()
         (g, std::bind(get_eigenvector(), placeholders::_1, g.GetVertexIndex(),
                       placeholders::_2, placeholders::_3, epsilon, max_iter,
                       std::ref(eig)),
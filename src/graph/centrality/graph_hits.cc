@@ -67,7 +67,7 @@ long double hits(GraphInterface& g, boost::any w, boost::any x, boost::any y,
         w = weight_map_t(1);
 
     long double eig = 0;
-    run_action<>()
+    run_action_nogil<>()
         (g, std::bind(get_hits_dispatch(), placeholders::_1, g.GetVertexIndex(),
                       placeholders::_2,  placeholders::_3, y, epsilon, max_iter,
                       std::ref(eig)),
@@ -53,12 +53,13 @@ void katz(GraphInterface& g, boost::any w, boost::any c, boost::any beta,
     if(beta.empty())
         beta = beta_map_t(1.);
 
-    run_action<>()(g, std::bind(get_katz(), placeholders::_1, g.GetVertexIndex(),
-                                placeholders::_2, placeholders::_3,
-                                placeholders::_4, alpha, epsilon, max_iter),
-                   weight_props_t(),
-                   vertex_floating_properties(),
-                   beta_props_t())(w, c, beta);
+    run_action_nogil<>()
+        (g, std::bind(get_katz(), placeholders::_1, g.GetVertexIndex(),
+                      placeholders::_2, placeholders::_3,
+                      placeholders::_4, alpha, epsilon, max_iter),
+         weight_props_t(),
+         vertex_floating_properties(),
+         beta_props_t())(w, c, beta);
 }
 
 void export_katz()
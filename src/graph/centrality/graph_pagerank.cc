@@ -55,7 +55,7 @@ size_t pagerank(GraphInterface& g, boost::any rank, boost::any pers,
         weight = weight_map_t(1.0);
 
     size_t iter;
-    run_action<>()
+    run_action_nogil<>()
         (g, std::bind(get_pagerank(),
                       placeholders::_1, g.GetVertexIndex(), placeholders::_2,
                       placeholders::_3, placeholders::_4, d,
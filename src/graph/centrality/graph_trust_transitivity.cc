@@ -36,11 +36,11 @@ void trust_transitivity(GraphInterface& g, int64_t source, int64_t target,
     if (!belongs<vertex_floating_vector_properties>()(t))
         throw ValueException("vertex property must be of floating point valued vector type");
 
-    run_action<>()(g,
-                   bind<void>(get_trust_transitivity(), _1, g.GetVertexIndex(),
-                              source, target, _2, _3),
-                   edge_floating_properties(),
-                   vertex_floating_vector_properties())(c,t);
+    run_action_nogil<>()
+        (g, bind<void>(get_trust_transitivity(), _1, g.GetVertexIndex(),
+                       source, target, _2, _3),
+         edge_floating_properties(),
+         vertex_floating_vector_properties())(c,t);
 }
 
 void export_trust_transitivity()
@@ -395,15 +395,20 @@ boost::python::object do_move_sweep(GraphInterface& gi, GraphInterface& bgi,
 
     vmap_t merge_map = any_cast<vmap_t>(omerge_map);
 
-    run_action<graph_tool::detail::all_graph_views, boost::mpl::true_>()
-        (gi, std::bind(move_sweep_dispatch<emap_t, vmap_t, vemap_t>
-                       (eweight, vweight, oegroups, esrcpos, etgtpos,
-                        label, vlist, deg_corr, dense, multigraph, beta,
-                        sequential, parallel, random_move, c, verbose,
-                        gi.GetMaxEdgeIndex(), nmerges, ntries, merge_map,
-                        partition_stats, rng, S, nmoves, bgi),
-                       mrs, mrp, mrm, wr, b, placeholders::_1,
-                       std::ref(emat), sampler, cavity_sampler, weighted))();
+    {
+        // no python objects are touched during the sweep
+        GILRelease gil_release;
+
+        run_action<graph_tool::detail::all_graph_views, boost::mpl::true_>()
+            (gi, std::bind(move_sweep_dispatch<emap_t, vmap_t, vemap_t>
+                           (eweight, vweight, oegroups, esrcpos, etgtpos,
+                            label, vlist, deg_corr, dense, multigraph, beta,
+                            sequential, parallel, random_move, c, verbose,
+                            gi.GetMaxEdgeIndex(), nmerges, ntries, merge_map,
+                            partition_stats, rng, S, nmoves, bgi),
+                           mrs, mrp, mrm, wr, b, placeholders::_1,
+                           std::ref(emat), sampler, cavity_sampler, weighted))();
+    }
     return boost::python::make_tuple(S, nmoves);
 }
 
@@ -1127,7 +1127,69 @@ public:
     vector<pair<size_t, size_t> >& GetEntries() { return _entries; }
     vector<int>& GetDelta() { return _delta; }
 
+    // The block histogram of the neighbours of a vertex does not depend on
+    // the target block, and is hence reused for all the move proposals of the
+    // same vertex, until the cache is invalidated.
+
+    void EnableCache(bool enable)
+    {
+        _cache = enable;
+        _hist_v = _null;
+        if (_cache && _hist_out_pos.empty())
+        {
+            _hist_out_pos.resize(_r_field_t.size(), _null);
+            if (is_directed::apply<Graph>::type::value)
+                _hist_in_pos.resize(_r_field_t.size(), _null);
+        }
+    }
+
+    bool IsCacheEnabled() { return _cache; }
+    bool IsCached(size_t v) { return _hist_v == v; }
+    void InvalidateCache() { _hist_v = _null; }
+
+    void ResetHist(size_t v)
+    {
+        for (auto& sw : _hist_out)
+            _hist_out_pos[sw.first] = _null;
+        for (auto& sw : _hist_in)
+            _hist_in_pos[sw.first] = _null;
+        _hist_out.clear();
+        _hist_in.clear();
+        _hist_self = 0;
+        _hist_v = v;
+    }
+
+    void AddHistTarget(size_t s, int w)
+    {
+        add_hist(s, w, _hist_out, _hist_out_pos);
+    }
+
+    void AddHistSource(size_t s, int w)
+    {
+        add_hist(s, w, _hist_in, _hist_in_pos);
+    }
+
+    void AddHistSelf(int w) { _hist_self += w; }
+
+    vector<pair<size_t, int> >& GetHistTarget() { return _hist_out; }
+    vector<pair<size_t, int> >& GetHistSource() { return _hist_in; }
+    int GetHistSelf() { return _hist_self; }
+
 private:
+    void add_hist(size_t s, int w, vector<pair<size_t, int> >& hist,
+                  vector<size_t>& pos)
+    {
+        if (pos[s] == _null)
+        {
+            pos[s] = hist.size();
+            hist.push_back(make_pair(s, w));
+        }
+        else
+        {
+            hist[pos[s]].second += w;
+        }
+    }
+
     pair<size_t, size_t> _rnr;
     size_t _null;
     vector<size_t> _r_field_t;
@@ -1136,8 +1198,55 @@ private:
     vector<size_t> _nr_field_s;
     vector<pair<size_t, size_t> > _entries;
     vector<int> _delta;
+
+    bool _cache = false;
+    size_t _hist_v;
+    vector<size_t> _hist_out_pos;
+    vector<size_t> _hist_in_pos;
+    vector<pair<size_t, int> > _hist_out;
+    vector<pair<size_t, int> > _hist_in;
+    int _hist_self = 0;
 };
 
+// compute the weighted histogram of the blocks of the neighbours of a vertex,
+// excluding self-loops, which are counted separately
+template <class Graph, class Vertex, class Vprop, class Eprop,
+          class NPolicy = standard_neighbours_policy>
+void neighbour_block_hist(Vertex v, Vprop& b, Eprop& eweights, Graph& g,
+                          EntrySet<Graph>& m_entries,
+                          const NPolicy& npolicy = NPolicy())
+{
+    typedef typename graph_traits<Graph>::vertex_descriptor vertex_t;
+
+    m_entries.ResetHist(v);
+
+    int self_count = 0;
+    for (auto e : npolicy.get_out_edges(v, g))
+    {
+        vertex_t u = target(e, g);
+        if (u == v)
+        {
+            if (!is_directed::apply<Graph>::type::value)
+            {
+                ++self_count;
+                if (self_count % 2 == 0)
+                    continue;
+            }
+            m_entries.AddHistSelf(eweights[e]);
+            continue;
+        }
+        m_entries.AddHistTarget(b[u], eweights[e]);
+    }
+
+    for (auto e : npolicy.get_in_edges(v, g))
+    {
+        vertex_t u = source(e, g);
+        if (u == v)
+            continue;
+        m_entries.AddHistSource(b[u], eweights[e]);
+    }
+}
+
 // obtain the necessary entries in the e_rs matrix which need to be modified
 // after the move
 template <class Graph, class BGraph, class Vertex, class Vprop, class Eprop,
@@ -1151,6 +1260,32 @@ void move_entries(Vertex v, Vertex nr, Vprop& b, Eprop& eweights, Graph& g,
 
     m_entries.SetMove(r, nr);
 
+    if (m_entries.IsCacheEnabled())
+    {
+        if (!m_entries.IsCached(v))
+            neighbour_block_hist(v, b, eweights, g, m_entries, npolicy);
+
+        for (auto& sw : m_entries.GetHistTarget())
+        {
+            m_entries.InsertDeltaTarget(r,  sw.first, -sw.second);
+            m_entries.InsertDeltaTarget(nr, sw.first, +sw.second);
+        }
+
+        int self_w = m_entries.GetHistSelf();
+        if (self_w > 0)
+        {
+            m_entries.InsertDeltaTarget(r,  r,  -self_w);
+            m_entries.InsertDeltaTarget(nr, nr, +self_w);
+        }
+
+        for (auto& sw : m_entries.GetHistSource())
+        {
+            m_entries.InsertDeltaSource(sw.first,  r, -sw.second);
+            m_entries.InsertDeltaSource(sw.first, nr, +sw.second);
+        }
+        return;
+    }
+
     int self_count = 0;
     for (auto e : npolicy.get_out_edges(v, g))
     {
@@ -1238,7 +1373,6 @@ double virtual_move_sparse(size_t v, size_t nr, Eprop& mrs, Vprop& mrp,
     //assert(mrp[r]  - kout >= 0);
 
     int dwr, dwnr;
-    set<int> bv, nbv;
     if (!overlap_stats.is_enabled())
     {
         dwr = dwnr = vweight[v];
@@ -1846,6 +1980,7 @@ void move_sweep(EMprop mrs, Vprop mrp, Vprop mrm, Vprop wr, Vprop b,
     S = 0;
 
     EntrySet<Graph> m_entries(B);
+    m_entries.EnableCache(true);
 
     vector<rng_t*> rngs;
     if (parallel)
@@ -1906,6 +2041,9 @@ void move_sweep(EMprop mrs, Vprop mrp, Vprop mrm, Vprop wr, Vprop b,
         if (nmerges > 0)
             past_moves.clear();
 
+        // the neighbours of v may have moved since it was last visited
+        m_entries.InvalidateCache();
+
         size_t j = 0;
         while (j < ntries)
         {
@@ -2042,6 +2180,9 @@ void move_sweep(EMprop mrs, Vprop mrp, Vprop mrm, Vprop wr, Vprop b,
         }
     }
 
+    // the moves below change the neighbourhoods between consecutive calls
+    m_entries.EnableCache(false);
+
     if (parallel && (nmerges == 0))
     {
         for (auto r : rngs)
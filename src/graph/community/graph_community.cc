@@ -94,6 +94,41 @@ double modularity(GraphInterface& g, boost::any weight, boost::any property)
     return modularity;
 }
 
+size_t modularity_local_moves(GraphInterface& g, boost::any weight,
+                              boost::any property, double gamma,
+                              size_t max_passes, rng_t& rng)
+{
+    size_t nmoves = 0;
+
+    typedef ConstantPropertyMap<int32_t,GraphInterface::edge_t> weight_map_t;
+    typedef boost::mpl::push_back<edge_scalar_properties, weight_map_t>::type
+        edge_props_t;
+
+    typedef property_map_types::apply<boost::mpl::vector<int32_t,int64_t>,
+                                      GraphInterface::vertex_index_map_t,
+                                      boost::mpl::bool_<false> >::type
+        allowed_community_properties;
+
+    if (!belongs<allowed_community_properties>()(property))
+        throw ValueException("vertex property is not of integer type int32_t "
+                             "or int64_t");
+
+    if(weight.empty())
+        weight = weight_map_t(1);
+
+    {
+        GILRelease gil_release;
+
+        run_action<graph_tool::detail::never_directed>()
+            (g, std::bind(get_modularity_local_moves(), placeholders::_1,
+                          placeholders::_2, placeholders::_3, gamma,
+                          max_passes, std::ref(rng), std::ref(nmoves)),
+             edge_props_t(), allowed_community_properties())
+            (weight, property);
+    }
+    return nmoves;
+}
+
 using namespace boost::python;
 
 
@@ -127,6 +162,7 @@ BOOST_PYTHON_MODULE(libgraph_tool_community)
 {
     def("community_structure", &community_structure);
     def("modularity", &modularity);
+    def("modularity_local_moves", &modularity_local_moves);
     def("community_network", &community_network);
     def("community_network_vavg", &community_network_vavg);
     def("community_network_eavg", &community_network_eavg);
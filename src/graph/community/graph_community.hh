@@ -58,8 +58,6 @@ struct get_communities
         typedef typename property_traits<WeightMap>::key_type weight_key_t;
 
 
-        auto random = std::bind(std::uniform_real_distribution<>(), std::ref(rng));
-
         stringstream out_str;
         ofstream out_file;
         if (verbose.second != "")
@@ -97,6 +95,8 @@ struct get_communities
             Tmin = numeric_limits<double>::epsilon();
         double cooling_rate = -(log(Tmin)-log(Tmax))/(n_iter-1);
 
+        parallel_rng<rng_t> prng(rng);
+
         // start the annealing
         for (size_t temp_count = 0; temp_count < n_iter; ++temp_count)
         {
@@ -105,69 +105,76 @@ struct get_communities
 
             vector<std::tuple<size_t, size_t, size_t> > updates;
 
-            // sample a new spin for every vertex
+            // The spins are updated synchronously: the new spins are written
+            // to temp_s, and the global counts are only changed at the end of
+            // the sweep, so the threads need only keep their own list of
+            // updates.
             int NV = num_vertices(g),i;
-            #pragma omp parallel for default(shared) private(i)\
-                reduction(+:E) schedule(runtime) if (NV > 100)
-            for (i = 0; i < NV; ++i)
+            #pragma omp parallel default(shared) private(i) \
+                reduction(+:E) if (NV > 100)
             {
-                vertex_t v = vertex(i, g);
-                if (v == graph_traits<Graph>::null_vertex())
-                    continue;
+                rng_t& trng = prng.get();
+                uniform_int_distribution<size_t> tsample_spin(0, n_spins-1);
+                uniform_real_distribution<> random;
 
-                size_t new_s;
+                vector<std::tuple<size_t, size_t, size_t> > tupdates;
+                unordered_map<size_t, double> ns; // number of neighbours with
+                                                  // a given spin 's' (weighted)
+
+                #pragma omp for schedule(runtime)
+                for (i = 0; i < NV; ++i)
                 {
-                    #pragma omp critical
-                    new_s = sample_spin(rng);
-                }
+                    vertex_t v = vertex(i, g);
+                    if (v == graph_traits<Graph>::null_vertex())
+                        continue;
 
-                unordered_map<size_t, double> ns; // number of neighbours with a
-                                                  // given spin 's' (weighted)
+                    size_t new_s = tsample_spin(trng);
 
-                // neighborhood spins info
-                typename graph_traits<Graph>::out_edge_iterator e, e_end;
-                for (tie(e,e_end) = out_edges(v,g); e != e_end; ++e)
-                {
-                    vertex_t t = target(*e, g);
-                    if (t != v)
-                        ns[s[t]] += get(weights, weight_key_t(*e));
-                }
+                    // neighborhood spins info
+                    ns.clear();
+                    typename graph_traits<Graph>::out_edge_iterator e, e_end;
+                    for (tie(e,e_end) = out_edges(v,g); e != e_end; ++e)
+                    {
+                        vertex_t t = target(*e, g);
+                        if (t != v)
+                            ns[s[t]] += get(weights, weight_key_t(*e));
+                    }
 
-                size_t k = out_degree_no_loops(v, g);
+                    size_t k = out_degree_no_loops(v, g);
 
-                double curr_e = gamma*Nnnks(k,s[v]) - ns[s[v]];
-                double new_e = gamma*Nnnks(k,new_s) - ns[new_s];
+                    double curr_e = gamma*Nnnks(k,s[v]) - ns[s[v]];
+                    double new_e = gamma*Nnnks(k,new_s) - ns[new_s];
 
-                double r;
-                {
-                    #pragma omp critical
-                    r = random();
-                }
+                    double r = random(trng);
 
-                if (new_e < curr_e || r < exp(-(new_e - curr_e)/T))
-                {
-                    temp_s[v] = new_s;
-                    curr_e = new_e;
+                    if (new_e < curr_e || r < exp(-(new_e - curr_e)/T))
                     {
-                        #pragma omp critical
-                        updates.push_back(std::make_tuple(k, size_t(s[v]),
-                                                          new_s));
-                        Ns[s[v]]--;
-                        Ns[new_s]++;
+                        temp_s[v] = new_s;
+                        curr_e = new_e;
+                        tupdates.push_back(std::make_tuple(k, size_t(s[v]),
+                                                           new_s));
                     }
+                    else
+                    {
+                        temp_s[v] = s[v];
+                    }
+                    E += curr_e;
                 }
-                else
-                {
-                    temp_s[v] = s[v];
-                }
-                E += curr_e;
+
+                #pragma omp critical
+                updates.insert(updates.end(), tupdates.begin(),
+                               tupdates.end());
             }
             swap(s, temp_s);
 
             for (typeof(updates.begin()) iter = updates.begin();
                  iter != updates.end(); ++iter)
+            {
+                Ns[std::get<1>(*iter)]--;
+                Ns[std::get<2>(*iter)]++;
                 Nnnks.Update(std::get<0>(*iter), std::get<1>(*iter),
                              std::get<2>(*iter));
+            }
 
             if (verbose.first)
             {
@@ -535,6 +542,121 @@ struct get_modularity
     }
 };
 
+// Local moving phase of the multilevel (Louvain) modularity maximization:
+// vertices are repeatedly moved to the neighbouring community that yields the
+// largest increase in (generalized) modularity, until no move improves it.
+// Communities are labelled by vertex indices, and the partition in 'b' must be
+// initialized with values in [0, N-1]. The coarse-graining step is done
+// separately, via get_community_network_vertices/_edges.
+//
+// If run in parallel, the vertices are moved asynchronously, and the community
+// totals are updated atomically. To avoid that isolated vertices endlessly
+// swap their communities, a vertex which is alone in its community is only
+// moved to another singleton community if it has a smaller label.
+
+struct get_modularity_local_moves
+{
+    template <class Graph, class WeightMap, class CommunityMap, class RNG>
+    void operator()(const Graph& g, WeightMap weights, CommunityMap b,
+                    double gamma, size_t max_passes, RNG& rng,
+                    size_t& nmoves) const
+    {
+        typedef typename graph_traits<Graph>::vertex_descriptor vertex_t;
+
+        size_t N = num_vertices(g);
+
+        // weighted degrees, including self-loops twice
+        vector<double> k(N, 0.);
+        vector<double> Kc(N, 0.);
+        vector<size_t> Nc(N, 0);
+        vector<vertex_t> vlist;
+        double W = 0;
+        for (auto v : vertices_range(g))
+        {
+            for (auto e : out_edges_range(v, g))
+                k[v] += get(weights, e);
+            Kc[b[v]] += k[v];
+            Nc[b[v]]++;
+            W += k[v];
+            vlist.push_back(v);
+        }
+
+        nmoves = 0;
+        if (W == 0)
+            return;
+
+        for (size_t pass = 0; pass < max_passes; ++pass)
+        {
+            std::shuffle(vlist.begin(), vlist.end(), rng);
+
+            size_t pmoves = 0;
+            int i, NV = vlist.size();
+            #pragma omp parallel default(shared) private(i) \
+                reduction(+:pmoves) if (NV > 1000)
+            {
+                unordered_map<size_t, double> kvc; // weight of the edges
+                                                   // between v and each
+                                                   // community
+
+                #pragma omp for schedule(runtime)
+                for (i = 0; i < NV; ++i)
+                {
+                    vertex_t v = vlist[i];
+                    size_t r = b[v];
+
+                    kvc.clear();
+                    kvc[r] = 0;
+                    for (auto e : out_edges_range(v, g))
+                    {
+                        vertex_t u = target(e, g);
+                        if (u == v)
+                            continue;
+                        kvc[b[u]] += get(weights, e);
+                    }
+
+                    double kv = k[v];
+                    size_t best_s = r;
+                    double best_dQ = kvc[r] - gamma * kv * (Kc[r] - kv) / W;
+                    double curr_dQ = best_dQ;
+                    for (auto& sw : kvc)
+                    {
+                        size_t s = sw.first;
+                        if (s == r)
+                            continue;
+                        double dQ = sw.second - gamma * kv * Kc[s] / W;
+                        if (dQ > best_dQ || (dQ == best_dQ && s < best_s))
+                        {
+                            best_s = s;
+                            best_dQ = dQ;
+                        }
+                    }
+
+                    if (best_s == r || best_dQ - curr_dQ <= 1e-12 * W)
+                        continue;
+
+                    if (Nc[r] == 1 && Nc[best_s] == 1 && best_s > r)
+                        continue;
+
+                    #pragma omp atomic
+                    Kc[r] -= kv;
+                    #pragma omp atomic
+                    Kc[best_s] += kv;
+                    #pragma omp atomic
+                    Nc[r]--;
+                    #pragma omp atomic
+                    Nc[best_s]++;
+                    b[v] = best_s;
+                    ++pmoves;
+                }
+            }
+
+            nmoves += pmoves;
+            if (pmoves == 0)
+                break;
+        }
+    }
+};
+
 } // graph_tool namespace
 
 #endif //GRAPH_COMMUNITY_HH
@@ -68,7 +68,7 @@ struct get_edmonds_karp_max_flow
 void edmonds_karp_max_flow(GraphInterface& gi, size_t src, size_t sink,
                            boost::any capacity, boost::any res)
 {
-    run_action<graph_tool::detail::always_directed>()
+    run_action_nogil<graph_tool::detail::always_directed>()
         (gi, std::bind(get_edmonds_karp_max_flow(),
                        placeholders::_1, gi.GetVertexIndex(), gi.GetEdgeIndex(),
                        gi.GetMaxEdgeIndex(),
@@ -95,7 +95,7 @@ struct get_kolmogorov_max_flow
 void kolmogorov_max_flow(GraphInterface& gi, size_t src, size_t sink,
                          boost::any capacity, boost::any res)
 {
-    run_action<graph_tool::detail::always_directed, boost::mpl::true_>()
+    run_action_nogil<graph_tool::detail::always_directed, boost::mpl::true_>()
         (gi, std::bind(get_kolmogorov_max_flow(),
                        placeholders::_1, gi.GetEdgeIndex(), gi.GetMaxEdgeIndex(),
                        gi.GetVertexIndex(), src, sink,  placeholders::_2,
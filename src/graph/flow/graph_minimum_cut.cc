@@ -55,7 +55,7 @@ double min_cut(GraphInterface& gi, boost::any weight, boost::any part_map)
     typedef boost::mpl::push_back<writable_edge_scalar_properties, cweight_t>::type
         weight_maps;
 
-    run_action<graph_tool::detail::never_directed>()
+    run_action_nogil<graph_tool::detail::never_directed>()
         (gi, std::bind(get_min_cut(),  placeholders::_1,  placeholders::_2,
                        placeholders::_3, std::ref(mc)),
          weight_maps(), writable_vertex_scalar_properties())(weight, part_map);
@@ -80,7 +80,7 @@ void get_residual_graph(GraphInterface& gi, boost::any capacity,
                                      GraphInterface::edge_index_map_t>::type
         emap_t;
     emap_t augment = boost::any_cast<emap_t>(oaugment);
-    run_action<>()
+    run_action_nogil<>()
         (gi, std::bind(do_get_residual_graph(), placeholders::_1,
                        placeholders::_2, placeholders::_3, augment),
          edge_scalar_properties(), edge_scalar_properties())(capacity, res);
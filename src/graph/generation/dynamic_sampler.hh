@@ -27,15 +27,23 @@ namespace graph_tool
 using namespace std;
 using namespace boost;
 
-template <class Value>
+// Sampler of discrete values with weights that can be changed dynamically.
+//
+// The weights are kept in a flat k-ary sum tree: the leaves are stored
+// contiguously in item order and each level above it holds the sums of
+// consecutive blocks of "Arity" nodes of the level below. With the default
+// arity of 8, the children of every node occupy a single cache line, and the
+// choice of child during sampling is done by a branchless scan over them,
+// which the compiler can vectorize.
+
+template <class Value, size_t Arity = 8>
 class DynamicSampler
 {
 public:
-    DynamicSampler() : _back(0) {}
+    DynamicSampler() {}
 
     DynamicSampler(const vector<Value>& items,
                    const vector<double>& probs)
-        : _back(0)
     {
         for (size_t i = 0; i < items.size(); ++i)
             insert(items[i], probs[i]);
@@ -43,103 +51,75 @@ public:
 
     typedef Value value_type;
 
-    size_t get_left(size_t i)   { return 2 * i + 1;               }
-    size_t get_right(size_t i)  { return 2 * i + 2;               }
-    size_t get_parent(size_t i) { return i > 0 ? (i - 1) / 2 : 0; }
-
     template <class RNG>
     const Value& sample(RNG& rng)
     {
         uniform_real_distribution<> sample(0, 1);
-        double u = _tree[0] * sample(rng), c = 0;
+        return _items[get_leaf(sample(rng))];
+    }
 
-        size_t pos = 0;
-        while (_idx[pos] < 0)
-        {
-            size_t l = get_left(pos);
-            double a = _tree[l];
-            if (u < a + c)
-            {
-                pos = l;
-            }
-            else
-            {
-                pos = get_right(pos);
-                c += a;
-            }
-        }
-        size_t i = _idx[pos];
-        return _items[i];
+    // draw out.size() independent samples; since the descents are
+    // independent of each other, they can be overlapped by the processor
+    template <class RNG>
+    void sample_n(RNG& rng, vector<Value>& out)
+    {
+        uniform_real_distribution<> sample(0, 1);
+        _u.resize(out.size());
+        for (size_t j = 0; j < _u.size(); ++j)
+            _u[j] = sample(rng);
+        for (size_t j = 0; j < _u.size(); ++j)
+            out[j] = _items[get_leaf(_u[j])];
     }
 
     size_t insert(const Value& v, double w)
     {
-        size_t pos;
+        size_t i;
         if (_free.empty())
         {
-            if (_back > 0)
-            {
-                // move parent to left leaf
-                pos = get_parent(_back);
-                size_t l = get_left(pos);
-                _idx[l] = _idx[pos];
-                _ipos[_idx[l]] = l;
-                _tree[l] = _tree[pos];
-                _idx[pos] = -1;
-
-                // position new item to the right
-                _back = get_right(pos);
-            }
-
-            pos = _back;
-            check_size(pos);
-
-            _idx[pos] = _items.size();
+            i = _items.size();
             _items.push_back(v);
-            _ipos.push_back(pos);
-            _tree[pos] = w;
-            _back++;
-            check_size(_back);
+            check_size(i);
         }
         else
         {
-            pos = _free.back();
-            _items[_idx[pos]] = v;
-            _tree[pos] = w;
+            i = _free.back();
+            _items[i] = v;
             _free.pop_back();
         }
 
-        insert_leaf_prob(pos);
-        return _idx[pos];
+        _tree[0][i] = w;
+        update(i);
+        return i;
     }
 
     void remove(size_t i)
     {
-        size_t pos = _ipos[i];
-        remove_leaf_prob(pos);
-        _free.push_back(pos);
+        _tree[0][i] = 0;
+        update(i);
+        _free.push_back(i);
     }
 
     void reset()
     {
         _items.clear();
         _tree.clear();
-        _idx.clear();
-        _back = 0;
         _free.clear();
     }
 
     void rebuild()
     {
+        vector<bool> is_free(_items.size(), false);
+        for (auto i : _free)
+            is_free[i] = true;
+
         vector<Value> items;
         vector<double> probs;
-
-        for (size_t i = 0; i < _tree.size(); ++i)
+        for (size_t i = 0; i < _items.size(); ++i)
         {
-            if (_idx[i] < 0)
+            if (is_free[i])
                 continue;
-            items.push_back(_items[_idx[i]]);
-            probs.push_back(_tree[i]);
+            items.push_back(_items[i]);
+            probs.push_back(_tree[0][i]);
         }
 
         reset();
@@ -150,48 +130,105 @@ public:
 
 private:
 
-    void check_size(size_t i)
+    // descend the tree, starting from the root, and return the item index
+    // corresponding to the given uniform value in [0, 1)
+    size_t get_leaf(double x)
     {
-        if (i >= _tree.size())
+        size_t pos = 0;
+        double u = _tree.back()[0] * x;
+        for (size_t l = _tree.size() - 1; l > 0; --l)
         {
-            _idx.resize(i + 1, -1);
-            _tree.resize(i + 1, 0);
+            const double* w = &_tree[l - 1][pos * Arity];
+
+            // count the children whose cumulative weight does not exceed u,
+            // and subtract their sum
+            size_t k = 0;
+            double c = 0, cs = 0;
+            for (size_t r = 0; r < Arity; ++r)
+            {
+                c += w[r];
+                bool skip = c <= u;
+                k += skip;
+                cs = skip ? c : cs;
+            }
+
+            // guard against round-off errors, which could lead us past the
+            // last child with nonzero weight
+            if (k == Arity)
+            {
+                do
+                {
+                    --k;
+                }
+                while (k > 0 && w[k] <= 0);
+                cs = 0;
+                for (size_t r = 0; r < k; ++r)
+                    cs += w[r];
+            }
+
+            u -= cs;
+            pos = pos * Arity + k;
         }
+        return pos;
     }
 
-    void remove_leaf_prob(size_t i)
+    void check_size(size_t i)
     {
-        size_t parent = i;
-        double w = _tree[i];
-        while (parent > 0)
+        if (_tree.empty())
+            _tree.emplace_back();
+
+        if (i < _tree[0].size())
+            return;
+
+        // leaves are added in whole blocks, and every level except the root
+        // is padded with zeros to a multiple of the arity
+        _tree[0].resize(_tree[0].size() + Arity, 0);
+
+        size_t l = 0;
+        while (_tree[l].size() > 1)
         {
-            parent = get_parent(parent);
-            _tree[parent] -= w;
+            size_t n = _tree[l].size() / Arity;
+            if (n > 1)
+                n = ((n + Arity - 1) / Arity) * Arity;
+            if (l + 1 == _tree.size())
+            {
+                _tree.emplace_back(n, 0);
+                for (size_t j = 0; j < n; ++j)
+                    update_node(l + 1, j);
+            }
+            else if (_tree[l + 1].size() < n)
+            {
+                _tree[l + 1].resize(n, 0);
+            }
+            ++l;
         }
-        _tree[i] = 0;
     }
 
-    void insert_leaf_prob(size_t i)
+    void update_node(size_t l, size_t j)
     {
-        size_t parent = i;
-        double w = _tree[i];
+        const double* w = &_tree[l - 1][j * Arity];
+        double c = 0;
+        for (size_t r = 0; r < Arity; ++r)
+            c += w[r];
+        _tree[l][j] = c;
+    }
 
-        while (parent > 0)
+    // the sums are recomputed from the children, instead of incremented, so
+    // that round-off errors do not accumulate after many changes
+    void update(size_t i)
+    {
+        for (size_t l = 1; l < _tree.size(); ++l)
         {
-            parent = get_parent(parent);
-            _tree[parent] += w;
+            i /= Arity;
+            update_node(l, i);
         }
     }
 
-
     vector<Value> _items;
-    vector<size_t> _ipos;   // position of the item in the tree
-
-    vector<double> _tree;  // tree nodes with weight sums
-    vector<int>    _idx;   // index in _items
-    int _back;             // last item in tree
-
-    vector<size_t> _free; // empty leafs
+    vector<vector<double>> _tree;  // _tree[0] are the leaf weights, and
+                                   // _tree.back()[0] is the total weight
+    vector<size_t> _free;          // empty leafs
+    vector<double> _u;             // buffer for batch sampling
 };
 
 
@@ -0,0 +1,191 @@
+// graph-tool -- a general graph modification and manipulation thingy
+//
+// Copyright (C) 2006-2015 Tiago de Paula Peixoto <tiago@skewed.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GRAPH_CONFIGURATION_HH
+#define GRAPH_CONFIGURATION_HH
+
+#include <vector>
+#include <algorithm>
+
+#include "graph.hh"
+#include "random.hh"
+
+namespace graph_tool
+{
+using namespace std;
+using namespace boost;
+
+// Configuration model via stub matching: every vertex receives as many stubs
+// (half-edges) as its degree, and the stubs are paired uniformly at random,
+// after a parallel shuffle. The resulting edges are inserted in bulk directly
+// into the adjacency lists. This samples from the multigraph ensemble;
+// self-loops and parallel edges can be optionally erased afterwards, which
+// changes the degrees slightly. O(V + E)
+
+struct gen_configuration
+{
+    template <class Graph, class DegArray>
+    void operator()(Graph& g, DegArray& in_deg, DegArray& out_deg,
+                    bool directed, bool self_loops, bool parallel_edges,
+                    rng_t& rng) const
+    {
+        typedef typename graph_traits<Graph>::vertex_descriptor vertex_t;
+
+        size_t N = out_deg.size();
+        if (directed && in_deg.size() != N)
+            throw ValueException("in- and out-degree sequences must have the "
+                                 "same length");
+
+        size_t N0 = num_vertices(g);
+        for (size_t i = 0; i < N; ++i)
+            add_vertex(g);
+
+        // sources and targets are separate stub lists if the graph is
+        // directed, otherwise all stubs go in the source list
+        vector<vertex_t> sources, targets;
+        make_stubs(out_deg, N0, sources);
+        if (directed)
+        {
+            make_stubs(in_deg, N0, targets);
+            if (sources.size() != targets.size())
+                throw ValueException("the sums of in- and out-degrees must be "
+                                     "the same");
+        }
+        else if (sources.size() % 2 != 0)
+        {
+            throw ValueException("the sum of degrees must be even");
+        }
+
+        vector<vertex_t> stubs;
+        parallel_shuffle(sources, stubs, rng);
+        vector<vertex_t>().swap(sources);
+
+        size_t E = directed ? stubs.size() : stubs.size() / 2;
+        vector<pair<vertex_t, vertex_t>> es(E);
+
+        int i, NE = E;
+        #pragma omp parallel for default(shared) private(i) \
+            schedule(runtime) if (NE > 100)
+        for (i = 0; i < NE; ++i)
+        {
+            if (directed)
+                es[i] = make_pair(stubs[i], targets[i]);
+            else
+                es[i] = make_pair(stubs[2 * i], stubs[2 * i + 1]);
+        }
+        vector<vertex_t>().swap(stubs);
+        vector<vertex_t>().swap(targets);
+
+        if (!self_loops || !parallel_edges)
+            erase_edges(es, N0 + N, directed, self_loops, parallel_edges);
+
+        add_edges(es, g);
+    }
+
+    template <class DegArray, class Vertex>
+    void make_stubs(DegArray& deg, size_t N0, vector<Vertex>& stubs) const
+    {
+        size_t N = deg.size();
+        vector<size_t> pos(N + 1, 0);
+        for (size_t v = 0; v < N; ++v)
+        {
+            if (deg[v] < 0)
+                throw ValueException("degrees must be non-negative");
+            pos[v + 1] = pos[v] + deg[v];
+        }
+
+        stubs.resize(pos[N]);
+
+        int v, NV = N;
+        #pragma omp parallel for default(shared) private(v) \
+            schedule(runtime) if (NV > 100)
+        for (v = 0; v < NV; ++v)
+            std::fill(stubs.begin() + pos[v], stubs.begin() + pos[v + 1],
+                      Vertex(N0 + v));
+    }
+
+    // Remove self-loops and/or parallel edges, by grouping the edges according
+    // to source and sorting the targets of each group. The edges that remain
+    // are returned ordered by source and target.
+    template <class Vertex>
+    void erase_edges(vector<pair<Vertex, Vertex>>& es, size_t N, bool directed,
+                     bool self_loops, bool parallel_edges) const
+    {
+        size_t E = es.size();
+
+        // undirected edges are made canonical, so that (u, v) and (v, u) are
+        // recognised as parallel
+        if (!directed)
+        {
+            int i, NE = E;
+            #pragma omp parallel for default(shared) private(i) \
+                schedule(runtime) if (NE > 100)
+            for (i = 0; i < NE; ++i)
+            {
+                if (es[i].first > es[i].second)
+                    std::swap(es[i].first, es[i].second);
+            }
+        }
+
+        vector<size_t> pos(N + 1, 0);
+        for (auto& e : es)
+            pos[e.first + 1]++;
+        for (size_t v = 0; v < N; ++v)
+            pos[v + 1] += pos[v];
+
+        vector<Vertex> ts(E);
+        vector<size_t> cursor(pos.begin(), pos.end() - 1);
+        for (auto& e : es)
+            ts[cursor[e.first]++] = e.second;
+
+        vector<size_t> kept(N + 1, 0);
+        int v, NV = N;
+        #pragma omp parallel for default(shared) private(v) \
+            schedule(runtime) if (NV > 100)
+        for (v = 0; v < NV; ++v)
+        {
+            auto begin = ts.begin() + pos[v];
+            auto end = ts.begin() + pos[v + 1];
+            if (!self_loops)
+                end = std::remove(begin, end, Vertex(v));
+            if (!parallel_edges)
+            {
+                std::sort(begin, end);
+                end = std::unique(begin, end);
+            }
+            kept[v + 1] = end - begin;
+        }
+
+        for (v = 0; v < NV; ++v)
+            kept[v + 1] += kept[v];
+
+        es.resize(kept[N]);
+
+        #pragma omp parallel for default(shared) private(v) \
+            schedule(runtime) if (NV > 100)
+        for (v = 0; v < NV; ++v)
+        {
+            size_t k = kept[v + 1] - kept[v];
+            for (size_t j = 0; j < k; ++j)
+                es[kept[v] + j] = make_pair(Vertex(v), ts[pos[v] + j]);
+        }
+    }
+};
+
+} // namespace graph_tool
+
+#endif // GRAPH_CONFIGURATION_HH
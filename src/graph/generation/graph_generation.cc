@@ -15,12 +15,14 @@
 // You should have received a copy of the GNU General Public License
 // along with this program. If not, see <http://www.gnu.org/licenses/>.
 
+#define BOOST_PYTHON_MAX_ARITY 40
 #include "graph.hh"
 #include "graph_util.hh"
 #include "graph_filtering.hh"
 #include "graph_generation.hh"
 #include "sampler.hh"
 #include "dynamic_sampler.hh"
+#include "numpy_bind.hh"
 #include <boost/python.hpp>
 
 using namespace std;
@@ -71,7 +73,9 @@ size_t random_rewire(GraphInterface& gi, string strat, size_t niter,
                      bool no_sweep, bool self_loops, bool parallel_edges,
                      bool alias, bool traditional, bool persist,
                      boost::python::object corr_prob, boost::any apin,
-                     boost::any block, bool cache, rng_t& rng, bool verbose);
+                     boost::any block, bool cache, bool parallel,
+                     size_t nsamples, boost::python::object callback,
+                     rng_t& rng, bool verbose);
 void predecessor_graph(GraphInterface& gi, GraphInterface& gpi,
                        boost::any pred_map);
 void line_graph(GraphInterface& gi, GraphInterface& lgi,
@@ -90,12 +94,26 @@ void lattice(GraphInterface& gi, boost::python::object oshape, bool periodic);
 void geometric(GraphInterface& gi, boost::python::object opoints, double r,
                boost::python::object orange, bool periodic, boost::any pos);
 void price(GraphInterface& gi, size_t N, double gamma, double c, size_t m,
-           rng_t& rng);
+           bool parallel, rng_t& rng);
 void complete(GraphInterface& gi, size_t N, bool directed, bool self_loops);
+void configuration(GraphInterface& gi, boost::python::object oin_deg,
+                   boost::python::object oout_deg, bool self_loops,
+                   bool parallel_edges, rng_t& rng);
 void circular(GraphInterface& gi, size_t N, size_t k, bool directed, bool self_loops);
+void sbm(GraphInterface& gi, boost::python::object ob,
+         boost::python::object oprobs, boost::python::object oout_deg,
+         boost::python::object oin_deg, rng_t& rng);
 
 using namespace boost::python;
 
+boost::python::object dynamic_sampler_sample_n(DynamicSampler<int>& sampler,
+                                               size_t n, rng_t& rng)
+{
+    vector<int> out(n);
+    sampler.sample_n(rng, out);
+    return wrap_vector_owned(out);
+}
+
 BOOST_PYTHON_MODULE(libgraph_tool_generation)
 {
     def("gen_graph", &generate_graph);
@@ -110,7 +128,9 @@ BOOST_PYTHON_MODULE(libgraph_tool_generation)
     def("geometric", &geometric);
     def("price", &price);
     def("complete", &complete);
+    def("configuration", &configuration);
     def("circular", &circular);
+    def("sbm", &sbm);
 
     class_<Sampler<int, boost::mpl::false_>>("Sampler",
                                              init<const vector<int>&, const vector<double>&>())
@@ -125,5 +145,6 @@ BOOST_PYTHON_MODULE(libgraph_tool_generation)
         .def("insert", &DynamicSampler<int>::insert)
         .def("remove", &DynamicSampler<int>::remove)
         .def("reset", &DynamicSampler<int>::reset)
+        .def("sample_n", &dynamic_sampler_sample_n)
         .def("rebuild", &DynamicSampler<int>::rebuild);
 }
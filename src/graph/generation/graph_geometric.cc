@@ -17,6 +17,7 @@
 
 #include "graph.hh"
 #include "graph_filtering.hh"
+#include "numpy_bind.hh"
 
 #include "graph_geometric.hh"
 
@@ -40,26 +41,19 @@ typedef property_map_types::apply<mpl::vector<vector<double> >,
 void geometric(GraphInterface& gi, python::object opoints, double r,
                python::object orange, bool periodic, boost::any pos)
 {
-    python::object shape = opoints.attr("shape");
-    size_t size = python::extract<size_t>(shape[0]);
-    vector<vector<double> > points(size);
+    multi_array_ref<double,2> points = get_array<double,2>(opoints);
     vector<pair<double, double> > range(python::len(orange));
 
-    size = python::extract<size_t>(shape[1]);
-    for(size_t i = 0; i < points.size(); ++i)
-    {
-        points[i].resize(size);
-        for (size_t j = 0; j < points[i].size(); ++j)
-            points[i][j] = python::extract<double>(opoints[i][j]);
-    }
-
     for(size_t i = 0; i < range.size(); ++i)
     {
         range[i].first = python::extract<double>(orange[i][0]);
         range[i].second = python::extract<double>(orange[i][1]);
     }
 
+    // the edges are inserted directly in the underlying adjacency lists
+    GILRelease gil_release;
     run_action<graph_views>()(gi, std::bind(get_geometric(), placeholders::_1,
+                                            std::ref(gi.GetGraph()),
                                             placeholders::_2, std::ref(points),
                                             std::ref(range), r,
                                             periodic),
@@ -19,20 +19,15 @@
 #define GRAPH_GEOMETRIC_HH
 
 #include <iostream>
-#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <cmath>
 
-#include <boost/functional/hash.hpp>
+#include "graph.hh"
 #include "graph_util.hh"
 
-#ifndef __clang__
-#include <ext/numeric>
-using __gnu_cxx::power;
-#else
-template <class Value>
-Value power(Value value, int n)
-{
-    return pow(value, n);
-}
+#ifdef USING_OPENMP
+#include <omp.h>
 #endif
 
 namespace graph_tool
@@ -40,133 +35,286 @@ namespace graph_tool
 using namespace std;
 using namespace boost;
 
+// Geometric graph via cell lists: space is divided into a grid of cells with
+// sides no smaller than r, so that every pair of points within distance r lies
+// in the same or in adjacent cells. The points are sorted by cell with a
+// counting sort, and copied into a flat array in this order, together with
+// the offset of each cell. Each pair of neighbouring cells is visited only
+// once, and the edges found are collected in per-thread buffers, which are
+// then inserted in bulk. The number of cells is limited to a few times the
+// number of points, by enlarging them if necessary, so that the whole grid can
+// be stored.
 
-template <class Point, class Range>
-void get_box(const Point& p, double w, vector<int>& box,
-             const Range& ranges, bool periodic)
+struct get_geometric
 {
-    if (box.size() != p.size())
-        box.resize(p.size());
-    for (size_t i = 0; i < p.size(); ++i)
+    template <class Graph, class BaseGraph, class Pos, class Points>
+    void operator()(Graph& g, BaseGraph& bg, Pos upos, Points& points,
+                    vector<pair<double, double> >& ranges,
+                    double r, bool periodic_boundary) const
     {
-        box[i] = int(floor(p[i] / w));
-        if (periodic && p[i] == ranges[i].second)
-            box[i] -= 1;
-    }
-}
+        typedef typename graph_traits<Graph>::vertex_descriptor vertex_t;
 
-template <class Point, class Range>
-double get_dist(const Point& p1, const Point& p2,
-                const Range& ranges, bool periodic)
-{
-    double r = 0, diff, size;
-    for (size_t i = 0; i < p1.size(); ++i)
-    {
-        diff = abs(p1[i] - p2[i]);
-        if (periodic)
-        {
-            size = abs(ranges[i].second - ranges[i].first);
-            diff = min(diff, abs(diff - size));
-        }
-        r += pow(diff, 2);
-    }
-    return sqrt(r);
-}
+        size_t N = points.shape()[0];
+        size_t D = points.shape()[1];
 
-void periodic(vector<int>& box, const vector<pair<int,int> >& ranges)
-{
-    for (size_t i = 0; i < box.size(); ++i)
-    {
-        if (box[i] >= ranges[i].second)
-            box[i] = ranges[i].first;
-        if (box[i] < ranges[i].first)
-            box[i] = ranges[i].second - 1;
-    }
-}
+        if (periodic_boundary && ranges.size() != D)
+            throw ValueException("the number of ranges must match the "
+                                 "dimension of the points");
 
+        size_t first = num_vertices(g);
+        for (size_t i = 0; i < N; ++i)
+            add_vertex(g);
 
-template <class Graph>
-bool is_adjacent(typename graph_traits<Graph>::vertex_descriptor v1,
-                 typename graph_traits<Graph>::vertex_descriptor v2,
-                 Graph& g)
-{
-    typename graph_traits<Graph>::out_edge_iterator e, e_end;
-    for (tie(e, e_end) = out_edges(v1, g); e != e_end; ++e)
-        if (target(*e, g) == v2)
-            return true;
-    return false;
-}
+        if (N == 0)
+            return;
 
-struct get_geometric
-{
-    template <class Graph, class Pos>
-    void operator()(Graph& g, Pos upos, vector<vector<double> >& points,
-                    vector<pair<double, double> >& ranges,
-                    double r, bool periodic_boundary) const
-    {
-        int N = points.size();
-        typename Pos::checked_t pos = upos.get_checked();
-        vector<int> box;
-        vector<pair<int, int> > box_ranges;
+        // bounding box of the points, or the given ranges if periodic
+        vector<double> lo(D), hi(D);
+        for (size_t j = 0; j < D; ++j)
+        {
+            if (periodic_boundary)
+            {
+                lo[j] = min(ranges[j].first, ranges[j].second);
+                hi[j] = max(ranges[j].first, ranges[j].second);
+            }
+            else
+            {
+                lo[j] = hi[j] = points[0][j];
+                for (size_t i = 1; i < N; ++i)
+                {
+                    lo[j] = min(lo[j], double(points[i][j]));
+                    hi[j] = max(hi[j], double(points[i][j]));
+                }
+            }
+        }
 
-        double w = 2 * r;
-        if (periodic_boundary)
+        // cell widths and number of cells in each dimension
+        vector<double> cw(D);
+        vector<size_t> nc(D);
+        double w = r;
+        while (true)
         {
-            box_ranges.resize(ranges.size());
-            for (size_t i = 0; i < ranges.size(); ++i)
+            double C = 1;
+            for (size_t j = 0; j < D; ++j)
             {
-                box_ranges[i].first = floor(ranges[i].first / w);
-                box_ranges[i].second = ceil(ranges[i].second / w);
+                double l = hi[j] - lo[j];
+                double n = (w > 0) ? floor(l / w) : numeric_limits<double>::infinity();
+                if (periodic_boundary)
+                    n = max(n, 1.);
+                else
+                    n += 1;
+                C *= n;
+                nc[j] = size_t(min(n, double(numeric_limits<size_t>::max())));
+                cw[j] = (periodic_boundary) ? l / n : w;
             }
+            if (C <= 4 * double(N))
+                break;
+            w = (w > 0) ? 2 * w : numeric_limits<double>::min();
+        }
+
+        size_t C = 1;
+        vector<size_t> stride(D);
+        for (size_t j = 0; j < D; ++j)
+        {
+            stride[j] = C;
+            C *= nc[j];
+        }
+
+        auto get_coord = [&](size_t i, size_t j) -> size_t
+            {
+                double x = points[i][j] - lo[j];
+                if (cw[j] <= 0)
+                    return 0;
+                double c = floor(x / cw[j]);
+                if (periodic_boundary)
+                {
+                    c = fmod(c, double(nc[j]));
+                    if (c < 0)
+                        c += nc[j];
+                }
+                return size_t(max(0., min(c, double(nc[j] - 1))));
+            };
+
+        // counting sort of the points by cell
+        vector<size_t> cell(N), cpos(C + 1, 0), order(N);
+        int i, NI = N;
+        #pragma omp parallel for default(shared) private(i) \
+            schedule(runtime) if (NI > 10000)
+        for (i = 0; i < NI; ++i)
+        {
+            size_t c = 0;
+            for (size_t j = 0; j < D; ++j)
+                c += get_coord(i, j) * stride[j];
+            cell[i] = c;
+            #pragma omp atomic
+            cpos[c + 1]++;
         }
 
-        std::unordered_multimap<vector<int>,
-                                typename graph_traits<Graph>::vertex_descriptor> boxes;
+        for (size_t c = 0; c < C; ++c)
+            cpos[c + 1] += cpos[c];
 
-        for (int i = 0; i < N; ++i)
+        vector<size_t> cursor(cpos.begin(), cpos.end() - 1);
+        #pragma omp parallel for default(shared) private(i) \
+            schedule(runtime) if (NI > 10000)
+        for (i = 0; i < NI; ++i)
         {
-            typename graph_traits<Graph>::vertex_descriptor v = add_vertex(g);
-            pos[v].resize(points[i].size());
-            copy(points[i].begin(), points[i].end(), pos[v].begin());
-            get_box(points[i], w, box, ranges, periodic_boundary);
-            boxes.insert(make_pair(box, v));
+            size_t p;
+            #pragma omp atomic capture
+            p = cursor[cell[i]]++;
+            order[p] = i;
         }
+        vector<size_t>().swap(cursor);
+        vector<size_t>().swap(cell);
 
-        int i;
-        #pragma omp parallel for default(shared) private(i, box) \
-            schedule(runtime) if (N > 100)
-        for (i = 0; i < N; ++i)
+        // the points of each cell are kept in index order, so that the
+        // result does not depend on the thread scheduling, and are copied
+        // contiguously
+        vector<double> x(N * D);
+        int c, NC = C;
+        #pragma omp parallel for default(shared) private(c) \
+            schedule(runtime) if (NC > 100)
+        for (c = 0; c < NC; ++c)
         {
-            typename graph_traits<Graph>::vertex_descriptor v = vertex(i, g);
+            std::sort(order.begin() + cpos[c], order.begin() + cpos[c + 1]);
+            for (size_t k = cpos[c]; k < cpos[c + 1]; ++k)
+                for (size_t j = 0; j < D; ++j)
+                    x[k * D + j] = points[order[k]][j];
+        }
 
-            get_box(points[i], w, box, ranges, periodic_boundary);
-            for (int k = 0; k < power(3, int(box.size())); ++k)
+        // positions of the new vertices
+        typename Pos::checked_t pos = upos.get_checked();
+        pos.reserve(first + N);
+        auto upos_n = pos.get_unchecked(first + N);
+        #pragma omp parallel for default(shared) private(i) \
+            schedule(runtime) if (NI > 10000)
+        for (i = 0; i < NI; ++i)
+        {
+            auto& p = upos_n[vertex(first + i, g)];
+            p.resize(D);
+            for (size_t j = 0; j < D; ++j)
+                p[j] = points[i][j];
+        }
+
+        auto get_dist = [&](size_t k, size_t l) -> double
             {
-                for (int j = 0; j < int(box.size()); ++j)
-                  box[j] += ((k / power(3, j)) % 3) - 1;
+                double d = 0;
+                for (size_t j = 0; j < D; ++j)
+                {
+                    double diff = abs(x[k * D + j] - x[l * D + j]);
+                    if (periodic_boundary)
+                        diff = min(diff, abs(diff - (hi[j] - lo[j])));
+                    d += diff * diff;
+                }
+                return sqrt(d);
+            };
 
-                if (periodic_boundary)
-                    periodic(box, box_ranges);
+        size_t n_offsets = 1;
+        for (size_t j = 0; j < D; ++j)
+            n_offsets *= 3;
+
+        size_t num_threads = 1;
+#ifdef USING_OPENMP
+        num_threads = omp_get_max_threads();
+#endif
+        vector<vector<pair<vertex_t, vertex_t>>> ebuf(num_threads);
+
+        #pragma omp parallel num_threads(num_threads) if (N > 10000)
+        {
+            size_t tid = 0, nt = 1;
+#ifdef USING_OPENMP
+            tid = omp_get_thread_num();
+            nt = omp_get_num_threads();
+#endif
+            // each thread gets a contiguous range of cells, with roughly the
+            // same number of points
+            size_t c_lo = lower_bound(cpos.begin(), cpos.end(),
+                                      (N * tid) / nt) - cpos.begin();
+            size_t c_hi = lower_bound(cpos.begin(), cpos.end(),
+                                      (N * (tid + 1)) / nt) - cpos.begin();
+            if (tid == nt - 1)
+                c_hi = C;
+
+            auto& es = ebuf[tid];
+            vector<size_t> coord(D), ncells;
+            for (size_t a = c_lo; a < min(c_hi, C); ++a)
+            {
+                if (cpos[a] == cpos[a + 1])
+                    continue;
+
+                for (size_t j = 0; j < D; ++j)
+                    coord[j] = (a / stride[j]) % nc[j];
 
-                typeof(boxes.begin()) iter, end;
-                for (tie(iter, end) = boxes.equal_range(box);
-                     iter != end; ++iter)
+                // neighbouring cells with a larger index; with periodic
+                // boundaries and less than three cells in a dimension, the
+                // same cell may be reached more than once
+                ncells.clear();
+                for (size_t o = 0; o < n_offsets; ++o)
                 {
-                    typename graph_traits<Graph>::vertex_descriptor w =
-                        iter->second;
-                    double d = get_dist(pos[v], pos[w], ranges,
-                                        periodic_boundary);
+                    size_t b = 0, m = o;
+                    bool valid = true;
+                    for (size_t j = 0; j < D; ++j)
+                    {
+                        int64_t cj = int64_t(coord[j]) + int64_t(m % 3) - 1;
+                        m /= 3;
+                        if (cj < 0 || cj >= int64_t(nc[j]))
+                        {
+                            if (!periodic_boundary)
+                            {
+                                valid = false;
+                                break;
+                            }
+                            cj = (cj + nc[j]) % nc[j];
+                        }
+                        b += cj * stride[j];
+                    }
+                    if (valid && b > a && cpos[b] < cpos[b + 1])
+                        ncells.push_back(b);
+                }
+                std::sort(ncells.begin(), ncells.end());
+                ncells.erase(std::unique(ncells.begin(), ncells.end()),
+                             ncells.end());
 
-                    if (w > v && d <= r &&
-                        (!periodic_boundary || !is_adjacent(v, w, g)))
+                for (size_t k = cpos[a]; k < cpos[a + 1]; ++k)
+                {
+                    for (size_t l = k + 1; l < cpos[a + 1]; ++l)
                     {
-                        #pragma omp critical
-                        add_edge(v, w, g);
+                        if (get_dist(k, l) <= r)
+                            es.push_back(make_pair(first + order[k],
+                                                   first + order[l]));
+                    }
+
+                    for (auto b : ncells)
+                    {
+                        for (size_t l = cpos[b]; l < cpos[b + 1]; ++l)
+                        {
+                            if (get_dist(k, l) > r)
+                                continue;
+                            size_t u = order[k], v = order[l];
+                            if (u > v)
+                                std::swap(u, v);
+                            es.push_back(make_pair(first + u, first + v));
+                        }
                     }
                 }
-                get_box(points[i], w, box, ranges, periodic_boundary);
             }
         }
+
+        vector<size_t> epos(ebuf.size() + 1, 0);
+        for (size_t t = 0; t < ebuf.size(); ++t)
+            epos[t + 1] = epos[t] + ebuf[t].size();
+        size_t E = epos.back();
+
+        vector<pair<vertex_t, vertex_t>> es(E);
+        int t, NT = ebuf.size();
+        #pragma omp parallel for default(shared) private(t) \
+            schedule(runtime) if (E > 10000)
+        for (t = 0; t < NT; ++t)
+        {
+            std::copy(ebuf[t].begin(), ebuf[t].end(), es.begin() + epos[t]);
+            vector<pair<vertex_t, vertex_t>>().swap(ebuf[t]);
+        }
+
+        add_edges(es, bg);
     }
 };
 
@@ -23,7 +23,9 @@ using namespace std;
 using namespace boost;
 using namespace graph_tool;
 
-// retrieves the line graph
+// retrieves the line graph; the number of line edges incident on each vertex
+// is counted first, so that they can be generated in parallel, and inserted
+// in bulk in the same order as they would be by a serial traversal
 
 struct get_line_graph
 {
@@ -33,58 +35,82 @@ struct get_line_graph
                     LineGraph& line_graph, EdgeIndexMap edge_index,
                     LGVertexIndex vmap) const
     {
-        typedef typename graph_traits<Graph>::vertex_descriptor vertex_t;
-        typedef boost::property<edge_index_t, size_t> EdgeProperty;
-
         typedef typename graph_traits<LineGraph>::vertex_descriptor lg_vertex_t;
-        typedef HashedDescriptorMap<EdgeIndexMap,lg_vertex_t>
-            edge_to_vertex_map_t;
-        edge_to_vertex_map_t edge_to_vertex_map(edge_index);
+
+        vector<lg_vertex_t> edge_to_vertex_map;
 
         typename LGVertexIndex::checked_t vertex_map = vmap.get_checked();
 
         for (auto e : edges_range(g))
         {
             auto v = add_vertex(line_graph);
-            edge_to_vertex_map[e] = v;
-            vertex_map[v] = edge_index[e];
+            size_t ei = edge_index[e];
+            if (ei >= edge_to_vertex_map.size())
+                edge_to_vertex_map.resize(ei + 1);
+            edge_to_vertex_map[ei] = v;
+            vertex_map[v] = ei;
+        }
+
+        int i, N = num_vertices(g);
+
+        vector<size_t> pos(N + 1, 0);
+        #pragma omp parallel for default(shared) private(i) \
+            schedule(runtime) if (N > 100)
+        for (i = 0; i < N; ++i)
+        {
+            auto v = vertex(i, g);
+            if (v == graph_traits<Graph>::null_vertex())
+                continue;
+            size_t k = 0;
+            line_edges(v, g, [&](const typename graph_traits<Graph>::edge_descriptor&,
+                                 const typename graph_traits<Graph>::edge_descriptor&)
+                       { ++k; });
+            pos[i + 1] = k;
+        }
+
+        for (size_t j = 0; j < size_t(N); ++j)
+            pos[j + 1] += pos[j];
+
+        vector<pair<lg_vertex_t, lg_vertex_t>> es(pos[N]);
+        #pragma omp parallel for default(shared) private(i) \
+            schedule(runtime) if (N > 100)
+        for (i = 0; i < N; ++i)
+        {
+            auto v = vertex(i, g);
+            if (v == graph_traits<Graph>::null_vertex())
+                continue;
+            size_t k = pos[i];
+            line_edges(v, g, [&](const typename graph_traits<Graph>::edge_descriptor& e1,
+                                 const typename graph_traits<Graph>::edge_descriptor& e2)
+                       {
+                           es[k++] = make_pair(edge_to_vertex_map[edge_index[e1]],
+                                               edge_to_vertex_map[edge_index[e2]]);
+                       });
         }
 
-        typedef typename property_map<LineGraph,edge_index_t>::type
-            line_edge_index_map_t;
-        line_edge_index_map_t line_edge_index(get(edge_index_t(), line_graph));
+        add_edges(es, line_graph);
+    }
 
+    // calls f(e1, e2) for every line edge generated at vertex v
+    template <class Graph, class F>
+    static void line_edges(typename graph_traits<Graph>::vertex_descriptor v,
+                           const Graph& g, F&& f)
+    {
         if (boost::is_directed(g))
         {
-            for (auto v : vertices_range(g))
-            {
-                for (auto e1 : out_edges_range(v, g))
-                {
-                    for (auto e2 : out_edges_range(target(e1, g), g))
-                    {
-                        add_edge(edge_to_vertex_map[e1],
-                                 edge_to_vertex_map[e2],
-                                 line_graph);
-                    }
-                }
-            }
+            for (auto e1 : out_edges_range(v, g))
+                for (auto e2 : out_edges_range(target(e1, g), g))
+                    f(e1, e2);
         }
         else
         {
-            for (auto v : vertices_range(g))
+            typename graph_traits<Graph>::out_edge_iterator e1, e2, e_end;
+            for (tie(e1, e_end) = out_edges(v, g); e1 != e_end; ++e1)
             {
-                typename graph_traits<Graph>::out_edge_iterator e1, e2, e_end;
-                for (tie(e1, e_end) = out_edges(v, g); e1 != e_end; ++e1)
+                for (e2 = e1; e2 != e_end; ++e2)
                 {
-                    for (e2 = e1; e2 != e_end; ++e2)
-                    {
-                        if (*e1 != *e2)
-                        {
-                            add_edge(edge_to_vertex_map[*e1],
-                                     edge_to_vertex_map[*e2],
-                                     line_graph).first;
-                        }
-                    }
+                    if (*e1 != *e2)
+                        f(*e1, *e2);
                 }
             }
         }
@@ -99,6 +125,7 @@ void line_graph(GraphInterface& gi, GraphInterface& lgi,
                                       boost::mpl::false_>::type
         vertex_properties;
 
+    GILRelease gil_release;
     run_action<>()(gi, std::bind(get_line_graph(), placeholders::_1,
                                  gi.GetVertexIndex(),
                                  std::ref(lgi.GetGraph()), lgi.GetEdgeIndex(),
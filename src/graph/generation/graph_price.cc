@@ -26,8 +26,26 @@ using namespace graph_tool;
 
 
 void price(GraphInterface& gi, size_t N, double gamma, double c, size_t m,
-           rng_t& rng)
+           bool parallel, rng_t& rng)
 {
-    run_action<>()(gi, std::bind(get_price(), placeholders::_1, N, gamma, c, m,
-                                 std::ref(rng)))();
+    if (!parallel)
+    {
+        run_action<>()(gi, std::bind(get_price(), placeholders::_1, N, gamma, c,
+                                     m, std::ref(rng)))();
+        return;
+    }
+
+    if (gamma != 1 || c < 0)
+        throw ValueException("parallel generation is only possible if "
+                             "gamma == 1 and c >= 0");
+    if (gi.IsVertexFilterActive() || gi.IsEdgeFilterActive())
+        throw ValueException("parallel generation is not possible if the "
+                             "seed graph is filtered");
+
+    // the new edges are inserted directly in the underlying adjacency lists
+    GILRelease gil_release;
+    run_action<>()(gi, std::bind(get_price_parallel(), placeholders::_1,
+                                 std::ref(gi.GetGraph()),
+                                 gi.GetDirected() && gi.GetReversed(), N, c,
+                                 m, std::ref(rng)))();
 }
@@ -26,6 +26,8 @@
 #include <unordered_set>
 
 #include <map>
+#include <vector>
+#include <algorithm>
 #include <iostream>
 
 namespace graph_tool
@@ -98,6 +100,188 @@ struct get_price
     }
 };
 
+// Parallel version of the above for linear preferential attachment (gamma ==
+// 1), based on the copy model: choosing a vertex with probability
+// proportional to k + c is the same as choosing a uniformly random vertex with
+// probability proportional to c * N, or otherwise the end of a uniformly
+// random existing edge (its target, if the graph is directed). Since every new
+// edge only copies from edges that are older than its source, all choices can
+// be made independently in parallel, and are resolved afterwards by following
+// the chains of copied edges, which are short. Repeated targets of the same
+// vertex are redrawn, as in get_price(). The new edges are inserted in bulk
+// directly into the adjacency lists. O(V + E)
+
+struct get_price_parallel
+{
+    template <class Graph, class BaseGraph>
+    void operator()(Graph& g, BaseGraph& bg, bool reversed, size_t N,
+                    double c, size_t m, rng_t& rng) const
+    {
+        typedef typename graph_traits<Graph>::vertex_descriptor vertex_t;
+        typedef typename mpl::if_<typename is_directed::apply<Graph>::type,
+                                  in_degreeS, out_degreeS>::type DegSelector;
+        bool directed = is_directed::apply<Graph>::type::value;
+
+        // seed vertices, and the edge ends that can be copied
+        vector<vertex_t> vs, ends;
+        size_t n_possible = 0;
+        typename graph_traits<Graph>::vertex_iterator vi, vi_end;
+        for (tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi)
+        {
+            vs.push_back(*vi);
+            if (DegSelector()(*vi, g) + c > 0)
+                ++n_possible;
+        }
+
+        typename graph_traits<Graph>::edge_iterator ei, ei_end;
+        for (tie(ei, ei_end) = edges(g); ei != ei_end; ++ei)
+        {
+            if (!directed)
+                ends.push_back(source(*ei, g));
+            ends.push_back(target(*ei, g));
+        }
+
+        if (n_possible == 0)
+            throw GraphException("Cannot connect edges: probabilities are <= 0!");
+
+        // new vertices become possible targets as soon as they are added,
+        // except in the directed case with c == 0, since their in-degree is
+        // zero
+        vector<size_t> epos(N + 1, 0);
+        for (size_t k = 0; k < N; ++k)
+        {
+            size_t n_k = n_possible;
+            if (!directed || c > 0)
+                n_k += k;
+            epos[k + 1] = epos[k] + min(m, n_k);
+        }
+        size_t M = epos[N];
+
+        size_t first = num_vertices(bg);
+        for (size_t k = 0; k < N; ++k)
+            add_vertex(bg);
+
+        // Each entry is either the final target, if non-negative, or
+        // -(j + 1), meaning that the target of new edge j is copied.
+        vector<int64_t> raw(M);
+
+        auto draw = [&](size_t k, rng_t& gen) -> int64_t
+            {
+                size_t nv = vs.size() + k;
+                size_t ne = ends.size() + (directed ? 1 : 2) * epos[k];
+                uniform_real_distribution<> sample(0, c * nv + ne);
+                if (sample(gen) < c * nv)
+                {
+                    uniform_int_distribution<size_t> vsample(0, nv - 1);
+                    size_t i = vsample(gen);
+                    if (i < vs.size())
+                        return vs[i];
+                    return first + i - vs.size();
+                }
+
+                uniform_int_distribution<size_t> esample(0, ne - 1);
+                size_t j = esample(gen);
+                if (j < ends.size())
+                    return ends[j];
+                j -= ends.size();
+                if (directed)
+                    return -int64_t(j + 1);
+                if (j % 2 == 1)
+                    return -int64_t(j / 2 + 1);
+                size_t l = upper_bound(epos.begin(), epos.end(), j / 2) -
+                    epos.begin() - 1;
+                return first + l;
+            };
+
+        parallel_rng<rng_t> prng(rng);
+
+        #pragma omp parallel if (M > 10000)
+        {
+            size_t tid = 0, nt = 1;
+#ifdef USING_OPENMP
+            tid = omp_get_thread_num();
+            nt = omp_get_num_threads();
+#endif
+            size_t lo = (N * tid) / nt;
+            size_t hi = (N * (tid + 1)) / nt;
+            rng_t& trng = prng.get();
+            for (size_t k = lo; k < hi; ++k)
+                for (size_t i = epos[k]; i < epos[k + 1]; ++i)
+                    raw[i] = draw(k, trng);
+        }
+
+        // follow the copy chains; entries are replaced by their final value
+        // as soon as they are known, which is seen by the other threads
+        size_t i;
+        #pragma omp parallel for default(shared) private(i) \
+            schedule(runtime) if (M > 10000)
+        for (i = 0; i < M; ++i)
+        {
+            int64_t t = raw[i];
+            while (t < 0)
+            {
+                #pragma omp atomic read
+                t = raw[-t - 1];
+            }
+            #pragma omp atomic write
+            raw[i] = t;
+        }
+
+        // find the vertices that received repeated targets
+        vector<uint8_t> repeated(N, false);
+        int k, NK = N;
+        #pragma omp parallel for default(shared) private(k) \
+            schedule(runtime) if (NK > 100)
+        for (k = 0; k < NK; ++k)
+        {
+            if (epos[k + 1] - epos[k] < 2)
+                continue;
+            vector<int64_t> ts(raw.begin() + epos[k],
+                               raw.begin() + epos[k + 1]);
+            std::sort(ts.begin(), ts.end());
+            repeated[k] = std::adjacent_find(ts.begin(), ts.end()) != ts.end();
+        }
+
+        // these are rare, and are redrawn serially, so that the outcome does
+        // not depend on the thread scheduling
+        std::unordered_set<int64_t> visited;
+        for (k = 0; k < NK; ++k)
+        {
+            if (!repeated[k])
+                continue;
+            visited.clear();
+            for (size_t i = epos[k]; i < epos[k + 1]; ++i)
+            {
+                while (visited.find(raw[i]) != visited.end())
+                {
+                    int64_t t = draw(k, rng);
+                    if (t < 0)
+                        t = raw[-t - 1];
+                    raw[i] = t;
+                }
+                visited.insert(raw[i]);
+            }
+        }
+
+        vector<pair<vertex_t, vertex_t>> es(M);
+        #pragma omp parallel for default(shared) private(k) \
+            schedule(runtime) if (NK > 100)
+        for (k = 0; k < NK; ++k)
+        {
+            for (size_t i = epos[k]; i < epos[k + 1]; ++i)
+            {
+                if (reversed)
+                    es[i] = make_pair(vertex_t(raw[i]), vertex_t(first + k));
+                else
+                    es[i] = make_pair(vertex_t(first + k), vertex_t(raw[i]));
+            }
+        }
+        vector<int64_t>().swap(raw);
+
+        add_edges(es, bg);
+    }
+};
+
 } // namespace graph_tool
 
 #endif // GRAPH_PRICE_HH
@@ -22,6 +22,8 @@
 #include <boost/bind.hpp>
 #include <boost/python.hpp>
 
+#include "numpy_bind.hh"
+
 #include "graph_rewiring.hh"
 
 using namespace graph_tool;
@@ -84,25 +86,27 @@ struct graph_rewire_block
     void operator()(Graph& g, EdgeIndexMap edge_index, CorrProb corr_prob,
                     PinMap pin, pair<bool, bool> rest, BlockProp block_prop,
                     pair<size_t, bool> iter_sweep,
-                    std::tuple<bool, bool, bool> cache_verbose, size_t& pcount, rng_t& rng)
+                    std::tuple<bool, bool, bool, bool> cache_verbose,
+                    pair<size_t, rewire_callback_t> samples, size_t& pcount,
+                    rng_t& rng)
         const
     {
         if (traditional)
         {
             graph_rewire<TradBlockRewireStrategy>()
                 (g, edge_index, corr_prob, pin, rest.first, rest.second, iter_sweep,
-                 cache_verbose, pcount, rng, PropertyBlock<BlockProp>(block_prop));
+                 cache_verbose, samples, pcount, rng, PropertyBlock<BlockProp>(block_prop));
         }
         else
         {
             if (alias)
                 graph_rewire<AliasProbabilisticRewireStrategy>()
                     (g, edge_index, corr_prob, pin, rest.first, rest.second, iter_sweep,
-                     cache_verbose, pcount, rng, PropertyBlock<BlockProp>(block_prop));
+                     cache_verbose, samples, pcount, rng, PropertyBlock<BlockProp>(block_prop));
             else
                 graph_rewire<ProbabilisticRewireStrategy>()
                     (g, edge_index, corr_prob, pin,  rest.first, rest.second, iter_sweep,
-                     cache_verbose, pcount, rng, PropertyBlock<BlockProp>(block_prop));
+                     cache_verbose, samples, pcount, rng, PropertyBlock<BlockProp>(block_prop));
         }
     }
 };
@@ -115,12 +119,13 @@ struct graph_rewire_correlated
     void operator()(Graph& g, EdgeIndexMap edge_index, CorrProb corr_prob,
                     PinMap pin, bool self_loops, bool parallel_edges,
                     pair<size_t, bool> iter_sweep,
-                    std::tuple<bool, bool, bool> cache_verbose,
+                    std::tuple<bool, bool, bool, bool> cache_verbose,
+                    pair<size_t, rewire_callback_t> samples,
                     size_t& pcount, rng_t& rng, BlockProp block_prop) const
     {
         graph_rewire<CorrelatedRewireStrategy>()
             (g, edge_index, corr_prob, pin, self_loops, parallel_edges, iter_sweep,
-             cache_verbose, pcount, rng, PropertyBlock<BlockProp>(block_prop));
+             cache_verbose, samples, pcount, rng, PropertyBlock<BlockProp>(block_prop));
     }
 };
 
@@ -129,11 +134,21 @@ size_t random_rewire(GraphInterface& gi, string strat, size_t niter,
                      bool no_sweep, bool self_loops, bool parallel_edges,
                      bool alias, bool traditional, bool persist,
                      boost::python::object corr_prob, boost::any apin,
-                     boost::any block, bool cache, rng_t& rng, bool verbose)
+                     boost::any block, bool cache, bool parallel,
+                     size_t nsamples, boost::python::object callback,
+                     rng_t& rng, bool verbose)
 {
     PythonFuncWrap corr(corr_prob);
     size_t pcount = 0;
 
+    rewire_callback_t sample_callback;
+    if (callback != boost::python::object())
+        sample_callback = [&](size_t k, vector<int64_t>& edge_list)
+            {
+                callback(k, wrap_vector_owned(edge_list));
+            };
+    auto samples = make_pair(nsamples, sample_callback);
+
     typedef property_map_type::apply<uint8_t,
                                      GraphInterface::edge_index_map_t>::type
         emap_t;
@@ -150,7 +165,8 @@ size_t random_rewire(GraphInterface& gi, string strat, size_t niter,
                            std::ref(corr), pin,
                            self_loops, parallel_edges,
                            make_pair(niter, no_sweep),
-                           std::make_tuple(persist, cache, verbose),
+                           std::make_tuple(persist, cache, verbose, parallel),
+                           samples,
                            std::ref(pcount), std::ref(rng)))();
     }
     else if (strat == "uncorrelated")
@@ -160,7 +176,8 @@ size_t random_rewire(GraphInterface& gi, string strat, size_t niter,
                            placeholders::_1, gi.GetEdgeIndex(), std::ref(corr),
                            pin, self_loops, parallel_edges,
                            make_pair(niter, no_sweep),
-                           std::make_tuple(persist, cache, verbose),
+                           std::make_tuple(persist, cache, verbose, parallel),
+                           samples,
                            std::ref(pcount), std::ref(rng)))();
     }
     else if (strat == "correlated")
@@ -172,7 +189,8 @@ size_t random_rewire(GraphInterface& gi, string strat, size_t niter,
                                placeholders::_1, gi.GetEdgeIndex(), std::ref(corr),
                                pin, self_loops, parallel_edges,
                                make_pair(niter, no_sweep),
-                               std::make_tuple(persist, cache, verbose),
+                               std::make_tuple(persist, cache, verbose, parallel),
+                               samples,
                                std::ref(pcount), std::ref(rng)))();
         }
         else
@@ -182,7 +200,8 @@ size_t random_rewire(GraphInterface& gi, string strat, size_t niter,
                                placeholders::_1, gi.GetEdgeIndex(), std::ref(corr),
                                pin, self_loops, parallel_edges,
                                make_pair(niter, no_sweep),
-                               std::make_tuple(persist, cache, verbose),
+                               std::make_tuple(persist, cache, verbose, parallel),
+                               samples,
                                std::ref(pcount), std::ref(rng),
                                placeholders::_2),
                  vertex_properties())(block);
@@ -195,7 +214,8 @@ size_t random_rewire(GraphInterface& gi, string strat, size_t niter,
                            placeholders::_1, gi.GetEdgeIndex(), std::ref(corr),
                            pin, self_loops, parallel_edges,
                            make_pair(niter, no_sweep),
-                           std::make_tuple(persist, cache, verbose),
+                           std::make_tuple(persist, cache, verbose, parallel),
+                           samples,
                            std::ref(pcount), std::ref(rng)))();
     }
     else if (strat == "blockmodel")
@@ -207,7 +227,8 @@ size_t random_rewire(GraphInterface& gi, string strat, size_t niter,
                            make_pair(self_loops, parallel_edges),
                            placeholders::_2,
                            make_pair(niter, no_sweep),
-                           std::make_tuple(persist, cache, verbose),
+                           std::make_tuple(persist, cache, verbose, parallel),
+                           samples,
                            std::ref(pcount), std::ref(rng)),
              vertex_properties())(block);
     }
@@ -20,6 +20,7 @@
 
 #include <unordered_set>
 #include <tuple>
+#include <functional>
 
 #include <boost/functional/hash.hpp>
 
@@ -32,6 +33,10 @@
 
 #include "random.hh"
 
+#ifdef USING_OPENMP
+#include <omp.h>
+#endif
+
 #ifdef HAVE_SPARSEHASH
 #include SPARSEHASH_INCLUDE(dense_hash_map)
 #endif
@@ -176,6 +181,55 @@ struct swap_edge
 
 };
 
+// one lock per vertex, used by the parallel rewiring sweep; without OpenMP
+// this does nothing
+class vertex_locks
+{
+public:
+    vertex_locks(size_t N)
+#ifdef USING_OPENMP
+        : _locks(N)
+    {
+        for (auto& l : _locks)
+            omp_init_lock(&l);
+    }
+#else
+    {}
+#endif
+
+    ~vertex_locks()
+    {
+#ifdef USING_OPENMP
+        for (auto& l : _locks)
+            omp_destroy_lock(&l);
+#endif
+    }
+
+    // the range must be sorted and free of repetitions, to avoid deadlocks
+    template <class Iter>
+    void lock(Iter begin, Iter end)
+    {
+#ifdef USING_OPENMP
+        for (; begin != end; ++begin)
+            omp_set_lock(&_locks[*begin]);
+#endif
+    }
+
+    template <class Iter>
+    void unlock(Iter begin, Iter end)
+    {
+#ifdef USING_OPENMP
+        for (; begin != end; ++begin)
+            omp_unset_lock(&_locks[*begin]);
+#endif
+    }
+
+private:
+#ifdef USING_OPENMP
+    vector<omp_lock_t> _locks;
+#endif
+};
+
 // used for verbose display
 void print_progress(size_t i, size_t n_iter, size_t current, size_t total,
                     stringstream& str)
@@ -280,19 +334,61 @@ struct get_null_key<pair<Type1, Type2>>
 };
 
 
+// strategies which can perform parallel sweeps, via
+// RewireStrategyBase::parallel_sweep()
+template <template <class Graph, class EdgeIndexMap, class CorrProb,
+                    class BlockDeg>
+          class RewireStrategy>
+struct has_parallel_sweep: public mpl::false_ {};
+
+template <class Graph, class EdgeIndexMap, class CorrProb, class BlockDeg>
+class RandomRewireStrategy;
+
+template <class Graph, class EdgeIndexMap, class CorrProb, class BlockDeg>
+class CorrelatedRewireStrategy;
+
+template <>
+struct has_parallel_sweep<RandomRewireStrategy>: public mpl::true_ {};
+
+template <>
+struct has_parallel_sweep<CorrelatedRewireStrategy>: public mpl::true_ {};
+
+// function called after each sample is obtained, when several samples are
+// generated in a row; it receives the sample index and the current edge list,
+// as a flat sequence of (source, target) pairs
+typedef std::function<void(size_t, vector<int64_t>&)> rewire_callback_t;
+
 // main rewire loop
 template <template <class Graph, class EdgeIndexMap, class CorrProb,
                     class BlockDeg>
           class RewireStrategy>
 struct graph_rewire
 {
+    template <class Strategy>
+    static size_t parallel_sweep(Strategy& rewire, vector<size_t>& edge_pos,
+                                 bool self_loops, bool parallel_edges,
+                                 bool persist, rng_t& rng, mpl::true_)
+    {
+        std::shuffle(edge_pos.begin(), edge_pos.end(), rng);
+        parallel_rng<rng_t> prng(rng);
+        return rewire.parallel_sweep(edge_pos, self_loops, parallel_edges,
+                                     persist, prng);
+    }
+
+    template <class Strategy>
+    static size_t parallel_sweep(Strategy&, vector<size_t>&, bool, bool, bool,
+                                 rng_t&, mpl::false_)
+    {
+        return 0;
+    }
 
     template <class Graph, class EdgeIndexMap, class CorrProb,
               class BlockDeg, class PinMap>
     void operator()(Graph& g, EdgeIndexMap edge_index, CorrProb corr_prob,
                     PinMap pin, bool self_loops, bool parallel_edges,
                     pair<size_t, bool> iter_sweep,
-                    std::tuple<bool, bool, bool> cache_verbose,
+                    std::tuple<bool, bool, bool, bool> cache_verbose,
+                    pair<size_t, rewire_callback_t> samples,
                     size_t& pcount, rng_t& rng, BlockDeg bd)
         const
     {
@@ -300,6 +396,7 @@ struct graph_rewire
         bool persist = std::get<0>(cache_verbose);
         bool cache = std::get<1>(cache_verbose);
         bool verbose = std::get<2>(cache_verbose);
+        bool parallel = std::get<3>(cache_verbose);
 
         vector<edge_t> edges;
         vector<size_t> edge_pos;
@@ -322,53 +419,96 @@ struct graph_rewire
         size_t niter;
         bool no_sweep;
         tie(niter, no_sweep) = iter_sweep;
+
+        // The same strategy instance (and hence its internal caches) is
+        // reused for all samples, each of which is obtained by running niter
+        // further iterations on top of the previous one.
+        size_t nsamples = samples.first;
+        rewire_callback_t& callback = samples.second;
+
+        typedef has_parallel_sweep<RewireStrategy> parallel_t;
+        bool psweep = parallel && parallel_t::value && !no_sweep;
+
         pcount = 0;
-        if (verbose)
-            cout << "rewiring edges: ";
-        stringstream str;
-        for (size_t i = 0; i < niter; ++i)
+        for (size_t k = 0; k < nsamples; ++k)
         {
-            random_edge_iter
-                ei_begin(edge_pos.begin(), edge_pos.end(), rng),
-                ei_end(edge_pos.end(), edge_pos.end(), rng);
+            if (verbose)
+            {
+                cout << "rewiring edges";
+                if (nsamples > 1)
+                    cout << " (sample " << k + 1 << " of " << nsamples << ")";
+                cout << ": ";
+            }
+            stringstream str;
 
-            for (random_edge_iter ei = ei_begin; ei != ei_end; ++ei)
+            for (size_t i = 0; i < niter; ++i)
             {
-                size_t e_pos = ei - ei_begin;
-                if (verbose)
-                    print_progress(i, niter, e_pos, no_sweep ? 1 : edges.size(),
-                                   str);
+                if (psweep)
+                {
+                    pcount += parallel_sweep(rewire, edge_pos, self_loops,
+                                             parallel_edges, persist, rng,
+                                             parallel_t());
+                    if (verbose)
+                        print_progress(i, niter, edges.size() - 1,
+                                       edges.size(), str);
+                    continue;
+                }
 
-                size_t e = *ei;
+                random_edge_iter
+                    ei_begin(edge_pos.begin(), edge_pos.end(), rng),
+                    ei_end(edge_pos.end(), edge_pos.end(), rng);
 
-                bool success = false;
-                do
+                for (random_edge_iter ei = ei_begin; ei != ei_end; ++ei)
                 {
-                    success = rewire(e, self_loops, parallel_edges);
-                }
-                while(persist && !success);
+                    size_t e_pos = ei - ei_begin;
+                    if (verbose)
+                        print_progress(i, niter, e_pos,
+                                       no_sweep ? 1 : edges.size(), str);
+
+                    size_t e = *ei;
+
+                    bool success = false;
+                    do
+                    {
+                        success = rewire(e, self_loops, parallel_edges);
+                    }
+                    while(persist && !success);
 
-                if (!success)
-                    ++pcount;
+                    if (!success)
+                        ++pcount;
 
-                if (no_sweep)
-                    break;
+                    if (no_sweep)
+                        break;
+                }
+            }
+            if (verbose)
+                cout << endl;
+
+            if (callback)
+            {
+                vector<int64_t> edge_list;
+                for (tie(e, e_end) = boost::edges(g); e != e_end; ++e)
+                {
+                    edge_list.push_back(source(*e, g));
+                    edge_list.push_back(target(*e, g));
+                }
+                callback(k, edge_list);
             }
         }
-        if (verbose)
-            cout << endl;
     }
 
     template <class Graph, class EdgeIndexMap, class CorrProb, class PinMap>
     void operator()(Graph& g, EdgeIndexMap edge_index, CorrProb corr_prob,
                     PinMap pin, bool self_loops, bool parallel_edges,
                     pair<size_t, bool> iter_sweep,
-                    std::tuple<bool, bool, bool> cache_verbose,
+                    std::tuple<bool, bool, bool, bool> cache_verbose,
+                    pair<size_t, rewire_callback_t> samples,
                     size_t& pcount, rng_t& rng)
         const
     {
         operator()(g, edge_index, corr_prob, pin, self_loops, parallel_edges,
-                   iter_sweep, cache_verbose, pcount, rng, DegreeBlock());
+                   iter_sweep, cache_verbose, samples, pcount, rng,
+                   DegreeBlock());
     }
 };
 
@@ -520,6 +660,65 @@ public:
         return true;
     }
 
+    // Parallel version of a full sweep over the edges in edge_pos, which is
+    // only available for strategies that implement get_target_edge() with an
+    // explicit rng. The swaps are done on a detached copy of the edge
+    // endpoints, and the graph itself is only updated at the end. The edges
+    // are split among the threads, and each proposal is validated and applied
+    // while holding the locks of the (at most four) vertices incident on the
+    // two edges involved. Since the proposals do not depend on the current
+    // state, the outcome is equivalent to a sequential sweep over the same
+    // proposals in some order, and the sampling remains uniform. Returns the
+    // number of rejected moves.
+    size_t parallel_sweep(vector<size_t>& edge_pos, bool self_loops,
+                          bool parallel_edges, bool persist,
+                          parallel_rng<rng_t>& prng)
+    {
+        size_t N = 0;
+        _pedges.resize(_edges.size());
+        for (size_t j = 0; j < _edges.size(); ++j)
+        {
+            vertex_t s = source(_edges[j], _g);
+            vertex_t t = target(_edges[j], _g);
+            _pedges[j] = make_pair(s, t);
+            N = std::max(N, size_t(std::max(s, t)) + 1);
+        }
+        vertex_locks locks(N);
+
+        size_t pcount = 0;
+        size_t i, E = edge_pos.size();
+        #pragma omp parallel for default(shared) private(i) \
+            schedule(runtime) reduction(+:pcount) if (E > 100)
+        for (i = 0; i < E; ++i)
+        {
+            rng_t& rng = prng.get();
+            bool success = false;
+            do
+            {
+                success = parallel_swap(edge_pos[i], self_loops,
+                                        parallel_edges, rng, locks);
+            }
+            while(persist && !success);
+
+            if (!success)
+                ++pcount;
+        }
+
+        // transfer the new endpoints to the graph
+        for (size_t j = 0; j < _edges.size(); ++j)
+        {
+            edge_t& e = _edges[j];
+            if (source(e, _g) == _pedges[j].first &&
+                target(e, _g) == _pedges[j].second)
+                continue;
+            remove_edge(e, _g);
+            e = add_edge(_pedges[j].first, _pedges[j].second, _g).first;
+        }
+        _pedges.clear();
+
+        return pcount;
+    }
+
 protected:
     Graph& _g;
     EdgeIndexMap _edge_index;
@@ -535,6 +734,102 @@ protected:
                                               typename property_map<Graph, vertex_index_t>::type>
         ::type::unchecked_t nmap_t;
     nmap_t _nmap;
+
+    // edge endpoints used during a parallel sweep; since they are also read
+    // before the corresponding locks are acquired, they are only accessed
+    // atomically
+    vector<pair<vertex_t, vertex_t>> _pedges;
+
+    vertex_t pend(size_t ei, bool second)
+    {
+        vertex_t& u = second ? _pedges[ei].second : _pedges[ei].first;
+        vertex_t v;
+        #pragma omp atomic read
+        v = u;
+        return v;
+    }
+
+    vertex_t psource(const pair<size_t, bool>& e)
+    {
+        return pend(e.first, e.second);
+    }
+
+    vertex_t ptarget(const pair<size_t, bool>& e)
+    {
+        return pend(e.first, !e.second);
+    }
+
+    void set_ptarget(const pair<size_t, bool>& e, vertex_t v)
+    {
+        vertex_t& u = e.second ? _pedges[e.first].first :
+            _pedges[e.first].second;
+        #pragma omp atomic write
+        u = v;
+    }
+
+    bool parallel_swap(size_t ei, bool self_loops, bool parallel_edges,
+                       rng_t& rng, vertex_locks& locks)
+    {
+        RewireStrategy& self = *static_cast<RewireStrategy*>(this);
+
+        pair<size_t, bool> e = make_pair(ei, false);
+        pair<size_t, bool> et = self.get_target_edge(e, parallel_edges, rng);
+
+        if (e.first == et.first)
+            return false;
+
+        // lock the endpoints of both edges, and make sure they were not
+        // modified by another thread in the meantime
+        std::array<vertex_t, 4> vs;
+        size_t nv;
+        vertex_t s, t, te_s, nt;
+        while (true)
+        {
+            s = psource(e);
+            t = ptarget(e);
+            te_s = psource(et);
+            nt = ptarget(et);
+
+            vs = {{s, t, te_s, nt}};
+            std::sort(vs.begin(), vs.end());
+            nv = std::unique(vs.begin(), vs.end()) - vs.begin();
+            locks.lock(vs.begin(), vs.begin() + nv);
+
+            if (s == psource(e) && t == ptarget(e) &&
+                te_s == psource(et) && nt == ptarget(et))
+                break;
+
+            locks.unlock(vs.begin(), vs.begin() + nv);
+        }
+
+        bool accept = true;
+
+        // reject self-loops if not allowed
+        if (!self_loops && (s == nt || t == te_s))
+            accept = false;
+
+        // reject parallel edges if not allowed
+        if (accept && !parallel_edges &&
+            (get_count(s, nt, _nmap, _g) > 0 ||
+             get_count(te_s, t, _nmap, _g) > 0))
+            accept = false;
+
+        if (accept)
+        {
+            if (!parallel_edges)
+            {
+                remove_count(s, t, _nmap, _g);
+                remove_count(te_s, nt, _nmap, _g);
+                add_count(s, nt, _nmap, _g);
+                add_count(te_s, t, _nmap, _g);
+            }
+            set_ptarget(e, nt);
+            set_ptarget(et, t);
+        }
+
+        locks.unlock(vs.begin(), vs.begin() + nv);
+        return accept;
+    }
 };
 
 // this will rewire the edges so that the combined (in, out) degree distribution
@@ -567,14 +862,20 @@ public:
         : base_t(g, edge_index, edges, rng, parallel_edges), _g(g) {}
 
     pair<size_t,bool> get_target_edge(pair<size_t,bool>& e, bool parallel_edges)
+    {
+        return get_target_edge(e, parallel_edges, base_t::_rng);
+    }
+
+    pair<size_t,bool> get_target_edge(pair<size_t,bool>& e, bool,
+                                      rng_t& rng)
     {
         std::uniform_int_distribution<> sample(0, base_t::_edges.size() - 1);
-        pair<size_t, bool> et = make_pair(sample(base_t::_rng), false);
+        pair<size_t, bool> et = make_pair(sample(rng), false);
         if (!is_directed::apply<Graph>::type::value)
         {
             std::bernoulli_distribution coin(0.5);
-            et.second = coin(base_t::_rng);
-            e.second = coin(base_t::_rng);
+            et.second = coin(rng);
+            e.second = coin(rng);
         }
         return et;
     }
@@ -613,9 +914,34 @@ public:
                              bool, rng_t& rng, bool parallel_edges)
         : base_t(g, edge_index, edges, rng, parallel_edges), _blockdeg(blockdeg), _g(g)
     {
+        // Each vertex is mapped to the index of its degree class, so that the
+        // (possibly expensive) block values are not touched while rewiring.
 #ifdef HAVE_SPARSEHASH
-        _edges_by_target.set_empty_key(get_null_key<deg_t>()());
+        google::dense_hash_map<deg_t, size_t, std::hash<deg_t>> class_index;
+        class_index.set_empty_key(get_null_key<deg_t>()());
+#else
+        std::unordered_map<deg_t, size_t> class_index;
 #endif
+        typename graph_traits<Graph>::vertex_iterator v, v_end;
+        for (tie(v, v_end) = boost::vertices(g); v != v_end; ++v)
+        {
+            deg_t d = get_deg(*v, _g);
+            auto iter = class_index.find(d);
+            size_t c;
+            if (iter == class_index.end())
+            {
+                c = class_index.size();
+                class_index[d] = c;
+                _edges_by_target.emplace_back();
+            }
+            else
+            {
+                c = iter->second;
+            }
+            if (*v >= _vclass.size())
+                _vclass.resize(*v + 1);
+            _vclass[*v] = c;
+        }
 
         for (size_t ei = 0; ei < base_t::_edges.size(); ++ei)
         {
@@ -625,32 +951,38 @@ public:
             edge_t& e = base_t::_edges[ei];
 
             vertex_t t = target(e, _g);
-            deg_t tdeg = get_deg(t, _g);;
-            _edges_by_target[tdeg].push_back(make_pair(ei, false));
+            _edges_by_target[_vclass[t]].push_back(make_pair(ei, false));
 
             if (!is_directed::apply<Graph>::type::value)
             {
                 t = source(e, _g);
-                deg_t tdeg = get_deg(t, _g);
-                _edges_by_target[tdeg].push_back(make_pair(ei, true));
+                _edges_by_target[_vclass[t]].push_back(make_pair(ei, true));
             }
         }
     }
 
-    pair<size_t,bool> get_target_edge(pair<size_t, bool>& e, bool parallel_edge)
+    pair<size_t,bool> get_target_edge(pair<size_t, bool>& e, bool parallel_edges)
+    {
+        return get_target_edge(e, parallel_edges, base_t::_rng);
+    }
+
+    // The degree class of each edge end never changes during rewiring, hence
+    // the classes can be read from the graph even when a parallel sweep is
+    // working on a detached copy of the endpoints.
+    pair<size_t,bool> get_target_edge(pair<size_t, bool>& e, bool,
+                                      rng_t& rng)
     {
         if (!is_directed::apply<Graph>::type::value)
         {
             std::bernoulli_distribution coin(0.5);
-            e.second = coin(base_t::_rng);
+            e.second = coin(rng);
         }
 
-        vertex_t t = target(e, base_t::_edges, _g);
-        deg_t tdeg = get_deg(t, _g);
-        auto& elist = _edges_by_target[tdeg];
+        size_t tc = _vclass[target(e, base_t::_edges, _g)];
+        auto& elist = _edges_by_target[tc];
         std::uniform_int_distribution<> sample(0, elist.size() - 1);
-        auto ep = elist[sample(base_t::_rng)];
-        if (get_deg(target(ep, base_t::_edges, _g), _g) != tdeg)
+        auto ep = elist[sample(rng)];
+        if (_vclass[target(ep, base_t::_edges, _g)] != tc)
             ep.second = not ep.second;
         return ep;
     }
@@ -665,18 +997,8 @@ public:
 private:
     BlockDeg _blockdeg;
 
-#ifdef HAVE_SPARSEHASH
-    typedef google::dense_hash_map<deg_t,
-                                   vector<pair<size_t, bool>>,
-                                   std::hash<deg_t>>
-        edges_by_end_deg_t;
-#else
-    typedef std::unordered_map<deg_t,
-                               vector<pair<size_t, bool>>>
-        edges_by_end_deg_t;
-#endif
-
-    edges_by_end_deg_t _edges_by_target;
+    vector<size_t> _vclass;
+    vector<vector<pair<size_t, bool>>> _edges_by_target;
 
 protected:
     const Graph& _g;
@@ -902,45 +1224,12 @@ public:
 
         if (_probs.empty())
         {
-            vector<deg_t> items;
-
-            for (auto s_iter = deg_set.begin(); s_iter != deg_set.end(); ++s_iter)
-                items.push_back(*s_iter);
-
-            for (auto s_iter = deg_set.begin(); s_iter != deg_set.end(); ++s_iter)
-            {
-                vector<double> probs;
-                double sum = 0;
-                for (auto t_iter = deg_set.begin(); t_iter != deg_set.end(); ++t_iter)
-                {
-                    double p = _corr_prob(*s_iter, *t_iter);
-                    // avoid zero probability to not get stuck in rejection step
-                    if (std::isnan(p) || std::isinf(p) || p <= 0)
-                        continue;
-                    probs.push_back(p);
-                    _probs[make_pair(*s_iter, *t_iter)] = log(p);
-                    sum += p;
-                }
-
-                _sampler[*s_iter] = new Sampler<deg_t, boost::mpl::false_>(items, probs);
-
-                auto& ps = _sprob[*s_iter];
-
-#ifdef HAVE_SPARSEHASH
-                ps.set_empty_key(get_null_key<deg_t>()());
-#endif
-                for (size_t i = 0; i < items.size(); ++i)
-                {
-                    double er = 0;
-                    if (!is_directed::apply<Graph>::type::value)
-                        er = max(_in_edges[items[i]].size() + _out_edges[items[i]].size(),
-                                 numeric_limits<double>::min());
-                    else
-                        er = max(_in_edges[items[i]].size(),
-                                 numeric_limits<double>::min());
-                    ps[items[i]] = exp(log(probs[i]) - log(sum) - log(er));
-                }
-            }
+            // The probabilities will be obtained from the supplied function.
+            // Since this requires one call for every pair of blocks, the
+            // tables of each source block are only built when they are first
+            // needed (see build_tables()).
+            _lazy = true;
+            _items.insert(_items.end(), deg_set.begin(), deg_set.end());
         }
         else
         {
@@ -993,9 +1282,64 @@ public:
             delete iter->second;
     }
 
+    // build the sampler and the probabilities of the given source block,
+    // querying the correlation function for every target block
+    Sampler<deg_t, boost::mpl::false_>* build_tables(const deg_t& s_deg)
+    {
+        vector<deg_t> items;
+        vector<double> probs;
+        double sum = 0;
+        for (auto& t_deg : _items)
+        {
+            double p = _corr_prob(s_deg, t_deg);
+            // avoid zero probability to not get stuck in rejection step
+            if (std::isnan(p) || std::isinf(p) || p <= 0)
+                continue;
+            items.push_back(t_deg);
+            probs.push_back(p);
+            _probs[make_pair(s_deg, t_deg)] = log(p);
+            sum += p;
+        }
+
+        auto& ps = _sprob[s_deg];
+
+#ifdef HAVE_SPARSEHASH
+        ps.set_empty_key(get_null_key<deg_t>()());
+#endif
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            // the number of edge ends in each block is invariant during the
+            // rewiring, hence it does not matter when this is computed
+            double er = 0;
+            if (!is_directed::apply<Graph>::type::value)
+                er = max(_in_edges[items[i]].size() + _out_edges[items[i]].size(),
+                         numeric_limits<double>::min());
+            else
+                er = max(_in_edges[items[i]].size(),
+                         numeric_limits<double>::min());
+            ps[items[i]] = exp(log(probs[i]) - log(sum) - log(er));
+        }
+
+        auto& sampler = _sampler[s_deg];
+        sampler = new Sampler<deg_t, boost::mpl::false_>(items, probs);
+        return sampler;
+    }
+
+    Sampler<deg_t, boost::mpl::false_>* get_sampler(const deg_t& s_deg)
+    {
+        auto iter = _sampler.find(s_deg);
+        if (iter != _sampler.end())
+            return iter->second;
+        if (_lazy)
+            return build_tables(s_deg);
+        return nullptr;
+    }
+
     double get_prob(const deg_t& s_deg, const deg_t& t_deg)
     {
         static const double zero = log(numeric_limits<double>::min());
+        if (_lazy)
+            get_sampler(s_deg);
         auto k = make_pair(s_deg, t_deg);
         auto iter = _probs.find(k);
         if (iter == _probs.end())
@@ -1005,6 +1349,8 @@ public:
 
     double get_sprob(const deg_t& s_deg, const deg_t& t_deg)
     {
+        if (_lazy)
+            get_sampler(s_deg);
         auto& pr = _sprob[s_deg];
         auto iter = pr.find(t_deg);
         if (iter == pr.end())
@@ -1032,11 +1378,11 @@ public:
         deg_t s_deg = get_deg(s, _g);
         deg_t t_deg = get_deg(t, _g);
 
-        auto iter = _sampler.find(s_deg);
-        if (iter == _sampler.end())
+        auto sampler = get_sampler(s_deg);
+        if (sampler == nullptr)
             throw GraphException("Block label without defined connection probability!");
 
-        deg_t nt = iter->second->sample(base_t::_rng);
+        deg_t nt = sampler->sample(base_t::_rng);
 
         if (_in_edges[nt].empty() && _out_edges[nt].empty())
             return e; // reject
@@ -1223,6 +1569,9 @@ private:
     edge_map_t _out_edges;
     vector<size_t> _in_pos;
     vector<size_t> _out_pos;
+
+    bool _lazy = false;    // whether the tables are built on demand
+    vector<deg_t> _items;  // all blocks, if _lazy == true
 };
 
 
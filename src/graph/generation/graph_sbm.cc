@@ -0,0 +1,41 @@
+// graph-tool -- a general graph modification and manipulation thingy
+//
+// Copyright (C) 2006-2015 Tiago de Paula Peixoto <tiago@skewed.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "graph.hh"
+#include "numpy_bind.hh"
+
+#include "graph_sbm.hh"
+
+#include <boost/python.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace graph_tool;
+
+void sbm(GraphInterface& gi, python::object ob, python::object oprobs,
+         python::object oout_deg, python::object oin_deg, rng_t& rng)
+{
+    multi_array_ref<int64_t,1> b = get_array<int64_t,1>(ob);
+    multi_array_ref<double,2> probs = get_array<double,2>(oprobs);
+    multi_array_ref<double,1> out_deg = get_array<double,1>(oout_deg);
+    multi_array_ref<double,1> in_deg = get_array<double,1>(oin_deg);
+
+    // the edges are inserted directly in the underlying adjacency lists
+    GILRelease gil_release;
+    gen_sbm()(gi.GetGraph(), b, probs, out_deg, in_deg, gi.GetDirected(),
+              rng);
+}
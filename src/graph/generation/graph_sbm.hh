@@ -0,0 +1,184 @@
+// graph-tool -- a general graph modification and manipulation thingy
+//
+// Copyright (C) 2006-2015 Tiago de Paula Peixoto <tiago@skewed.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GRAPH_SBM_HH
+#define GRAPH_SBM_HH
+
+#include <vector>
+#include <algorithm>
+
+#include "graph.hh"
+#include "random.hh"
+#include "sampler.hh"
+
+namespace graph_tool
+{
+using namespace std;
+using namespace boost;
+
+// Degree-corrected stochastic blockmodel, in its Poisson form: the number of
+// edges between blocks r and s is Poisson distributed, with a mean given by
+// the entry (r, s) of the probs matrix (or half of it for r == s, if the graph
+// is undirected), and the endpoints of each edge are chosen inside their
+// blocks with probability proportional to the propensity of each vertex. The
+// Chung-Lu (expected degree) model is the special case with a single
+// block. All edge counts are drawn first, and the edges are then sampled in
+// parallel into a preallocated list, which is inserted in bulk.
+// O(V + E + B^2)
+
+struct gen_sbm
+{
+    template <class Graph, class BArray, class PArray, class DArray>
+    void operator()(Graph& g, BArray& b, PArray& probs, DArray& out_deg,
+                    DArray& in_deg, bool directed, rng_t& rng) const
+    {
+        typedef typename graph_traits<Graph>::vertex_descriptor vertex_t;
+
+        size_t N = b.size();
+        size_t B = probs.shape()[0];
+        if (probs.shape()[1] != B)
+            throw ValueException("the matrix of edge counts must be square");
+        if ((out_deg.size() > 0 && out_deg.size() != N) ||
+            (in_deg.size() > 0 && in_deg.size() != N))
+            throw ValueException("the propensities must have the same length "
+                                 "as the block labels");
+
+        size_t N0 = num_vertices(g);
+        for (size_t i = 0; i < N; ++i)
+            add_vertex(g);
+
+        vector<vector<vertex_t>> members(B);
+        for (size_t i = 0; i < N; ++i)
+        {
+            if (b[i] < 0 || size_t(b[i]) >= B)
+                throw ValueException("invalid block label: " +
+                                     lexical_cast<string>(b[i]));
+            members[b[i]].push_back(N0 + i);
+        }
+
+        // the endpoints are chosen with the alias method inside each block;
+        // the in-propensities are only used if the graph is directed
+        vector<Sampler<vertex_t>> out_sampler, in_sampler;
+        vector<double> out_mass, in_mass;
+        make_samplers(members, b, out_deg, out_sampler, out_mass);
+        if (directed)
+            make_samplers(members, b, in_deg.size() > 0 ? in_deg : out_deg,
+                          in_sampler, in_mass);
+        auto& t_sampler = directed ? in_sampler : out_sampler;
+        auto& t_mass = directed ? in_mass : out_mass;
+
+        // number of edges between each pair of blocks
+        vector<pair<size_t, size_t>> rs;
+        vector<size_t> epos(1, 0);
+        for (size_t r = 0; r < B; ++r)
+        {
+            for (size_t s = directed ? 0 : r; s < B; ++s)
+            {
+                double l = probs[r][s];
+                if (!directed && r == s)
+                    l /= 2;
+                if (std::isnan(l) || std::isinf(l) || l < 0)
+                    throw ValueException("invalid expected number of edges "
+                                         "between blocks " +
+                                         lexical_cast<string>(r) + " and " +
+                                         lexical_cast<string>(s) + ": " +
+                                         lexical_cast<string>(l));
+                if (l == 0)
+                    continue;
+                if (out_mass[r] <= 0 || t_mass[s] <= 0)
+                    throw ValueException("blocks " + lexical_cast<string>(r) +
+                                         " and " + lexical_cast<string>(s) +
+                                         " must be connected, but one of them"
+                                         " is empty or has zero propensity");
+                poisson_distribution<size_t> poisson(l);
+                size_t m = poisson(rng);
+                if (m == 0)
+                    continue;
+                rs.emplace_back(r, s);
+                epos.push_back(epos.back() + m);
+            }
+        }
+
+        size_t E = epos.back();
+        vector<pair<vertex_t, vertex_t>> es(E);
+
+        parallel_rng<rng_t> prng(rng);
+
+        #pragma omp parallel if (E > 10000)
+        {
+            size_t tid = 0, nt = 1;
+#ifdef USING_OPENMP
+            tid = omp_get_thread_num();
+            nt = omp_get_num_threads();
+#endif
+            size_t lo = (E * tid) / nt;
+            size_t hi = (E * (tid + 1)) / nt;
+            rng_t& trng = prng.get();
+
+            size_t k = upper_bound(epos.begin(), epos.end(), lo) -
+                epos.begin() - 1;
+            for (size_t i = lo; i < hi; ++i)
+            {
+                while (epos[k + 1] <= i)
+                    ++k;
+                size_t r = rs[k].first;
+                size_t s = rs[k].second;
+                vertex_t u = out_sampler[r].sample(trng);
+                vertex_t v = t_sampler[s].sample(trng);
+                es[i] = make_pair(u, v);
+            }
+        }
+
+        add_edges(es, g);
+    }
+
+    template <class Vertex, class BArray, class DArray>
+    void make_samplers(vector<vector<Vertex>>& members, BArray& b,
+                       DArray& deg, vector<Sampler<Vertex>>& samplers,
+                       vector<double>& mass) const
+    {
+        size_t B = members.size();
+        vector<vector<double>> weights(B);
+        for (size_t r = 0; r < B; ++r)
+            weights[r].reserve(members[r].size());
+        for (size_t i = 0; i < b.size(); ++i)
+        {
+            double w = 1;
+            if (deg.size() > 0)
+            {
+                w = deg[i];
+                if (std::isnan(w) || std::isinf(w) || w < 0)
+                    throw ValueException("invalid propensity: " +
+                                         lexical_cast<string>(w));
+            }
+            weights[b[i]].push_back(w);
+        }
+
+        samplers.reserve(B);
+        mass.resize(B, 0);
+        for (size_t r = 0; r < B; ++r)
+        {
+            for (auto w : weights[r])
+                mass[r] += w;
+            samplers.emplace_back(members[r], weights[r]);
+        }
+    }
+};
+
+} // namespace graph_tool
+
+#endif // GRAPH_SBM_HH
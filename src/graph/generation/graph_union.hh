@@ -53,6 +53,48 @@ struct graph_union
             }
         }
 
+        add_union_edges(ug, g, vmap, emap);
+    }
+
+    // If the union graph is not a filtered or reversed view, the edges are
+    // inserted in bulk, and the edge map is filled in parallel with the
+    // indexes they will receive.
+    template <class Vertex, class Graph, class VertexMap, class EdgeMap>
+    void add_union_edges(adj_list<Vertex>& ug, Graph& g, VertexMap vmap,
+                         EdgeMap emap) const
+    {
+        typedef typename graph_traits<Graph>::edge_descriptor edge_t;
+        typedef typename graph_traits<adj_list<Vertex>>::edge_descriptor
+            uedge_t;
+
+        auto edge_index = get(edge_index_t(), g);
+        vector<edge_t> ges;
+        vector<pair<Vertex, Vertex>> es;
+        size_t max_idx = 0;
+        typename graph_traits<Graph>::edge_iterator e, e_end;
+        for (tie(e,e_end) = edges(g); e != e_end; ++e)
+        {
+            ges.push_back(*e);
+            es.emplace_back(vertex(vmap[source(*e,g)], g),
+                            vertex(vmap[target(*e,g)], g));
+            max_idx = max(max_idx, size_t(edge_index[*e]));
+        }
+
+        auto uemap = emap.get_unchecked(max_idx + 1);
+        int i, N = ges.size();
+        #pragma omp parallel for default(shared) private(i) \
+            schedule(runtime) if (N > 10000)
+        for (i = 0; i < N; ++i)
+            uemap[ges[i]] = uedge_t(es[i].first, es[i].second,
+                                    ug.get_next_index(i), false);
+
+        add_edges(es, ug);
+    }
+
+    template <class UnionGraph, class Graph, class VertexMap, class EdgeMap>
+    void add_union_edges(UnionGraph& ug, Graph& g, VertexMap vmap,
+                         EdgeMap emap) const
+    {
         typename graph_traits<Graph>::edge_iterator e, e_end;
         for (tie(e,e_end) = edges(g); e != e_end; ++e)
             emap[*e] = add_edge(vertex(vmap[source(*e,g)], g),
@@ -61,6 +103,10 @@ struct graph_union
 };
 
 
+// The properties are copied in parallel; the union property is already sized
+// for the union graph, and the maps filled by graph_union() above bound the
+// indexes of the original graph, so that no map is resized inside the loops.
+
 struct property_union
 {
     template <class UnionGraph, class Graph, class VertexMap, class EdgeMap,
@@ -81,9 +127,18 @@ struct property_union
     void dispatch(UnionGraph&, Graph& g, VertexMap vmap, EdgeMap,
                   UnionProp uprop, Prop prop, std::true_type) const
     {
-        typename graph_traits<Graph>::vertex_iterator v, v_end;
-        for (tie(v,v_end) = vertices(g); v != v_end; ++v)
-            uprop[vertex(vmap[*v], g)] = prop[*v];
+        auto uvmap = vmap.get_unchecked(num_vertices(g));
+        auto p = prop.get_unchecked(num_vertices(g));
+        int i, N = num_vertices(g);
+        #pragma omp parallel for default(shared) private(i) \
+            schedule(runtime) if (N > 100)
+        for (i = 0; i < N; ++i)
+        {
+            auto v = vertex(i, g);
+            if (v == graph_traits<Graph>::null_vertex())
+                continue;
+            uprop[vertex(uvmap[v], g)] = p[v];
+        }
     }
 
     template <class UnionGraph, class Graph, class VertexMap, class EdgeMap,
@@ -91,9 +146,21 @@ struct property_union
     void dispatch(UnionGraph&, Graph& g, VertexMap, EdgeMap emap,
                   UnionProp uprop, Prop prop, std::false_type) const
     {
-        typename graph_traits<Graph>::edge_iterator e, e_end;
-        for (tie(e,e_end) = edges(g); e != e_end; ++e)
-            uprop[emap[*e]] = prop[*e];
+        size_t M = emap.get_storage().size();
+        auto uemap = emap.get_unchecked(M);
+        auto p = prop.get_unchecked(M);
+        int i, N = num_vertices(g);
+        #pragma omp parallel for default(shared) private(i) \
+            schedule(runtime) if (N > 100)
+        for (i = 0; i < N; ++i)
+        {
+            auto v = vertex(i, g);
+            if (v == graph_traits<Graph>::null_vertex())
+                continue;
+            typename graph_traits<Graph>::out_edge_iterator e, e_end;
+            for (tie(e, e_end) = out_edges(v, g); e != e_end; ++e)
+                uprop[uemap[*e]] = p[*e];
+        }
     }
 
 };
@@ -35,6 +35,7 @@
 
 #include <boost/property_map/dynamic_property_map.hpp>
 #include <boost/tuple/tuple.hpp>
+#include <boost/mpl/vector/vector30.hpp>
 #include <boost/bind/bind.hpp>
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/properties.hpp>
@@ -360,12 +361,14 @@ void write_gml(std::ostream& out, const Graph& g, VertexIndexMap vertex_index,
     typedef typename graph_traits<Graph>::edge_descriptor edge_descriptor;
     typedef typename graph_traits<Graph>::vertex_descriptor vertex_descriptor;
 
-    typedef mpl::vector<bool, uint8_t, int8_t, uint32_t, int32_t,
-                        uint64_t, int64_t, float, double, long double,
-                        std::vector<uint8_t>, std::vector<int32_t>,
-                        std::vector<int64_t>, std::vector<double>,
-                        std::vector<long double>, std::vector<std::string>,
-                        std::string, python::object> value_types;
+    typedef mpl::vector21<bool, uint8_t, int8_t, uint32_t, int32_t,
+                          uint64_t, int64_t, float, double, long double,
+                          std::vector<uint8_t>, std::vector<int32_t>,
+                          std::vector<int64_t>, std::vector<double>,
+                          std::vector<long double>, std::vector<std::string>,
+                          std::string, python::object, std::vector<float>,
+                          std::vector<uint32_t>, std::vector<uint64_t>>
+        value_types;
 
     BOOST_STATIC_CONSTANT(bool, graph_is_directed =
                           (std::is_convertible<directed_category*,
@@ -19,8 +19,6 @@
 #include "graph_filtering.hh"
 #include "graph_properties.hh"
 
-#include <boost/lambda/lambda.hpp>
-#include <boost/lambda/bind.hpp>
 #include <iostream>
 
 using namespace std;
@@ -51,31 +49,23 @@ GraphInterface::~GraphInterface()
 }
 
 // this will get the number of vertices, either the "soft" O(1) way, or the hard
-// O(V) way, which is necessary if the graph is filtered
+// O(V) way, which is necessary if the graph is filtered. The latter is cached
+// until the graph or the filters change
 size_t GraphInterface::GetNumberOfVertices(bool filtered)
 {
-    size_t n = 0;
     if (filtered && IsVertexFilterActive())
-        run_action<>()(*this, lambda::var(n) =
-                       lambda::bind<size_t>(HardNumVertices(),lambda::_1))();
-    else
-        n = num_vertices(*_mg);
-    return n;
+        return GetActiveVertices().size();
+    return num_vertices(*_mg);
 }
 
-// this will get the number of edges, either the "soft" O(E) way, or the hard
-// O(E) way, which is necessary if the graph is filtered. Both cases are of
-// linear complexity, since num_edges() is O(E) in Boost's adjacency_list
+// this will get the number of edges, either the "soft" O(1) way, or the hard
+// O(E) way, which is necessary if the graph is filtered. The latter is cached
+// until the graph or the filters change
 size_t GraphInterface::GetNumberOfEdges(bool filtered)
 {
-    using namespace boost::lambda;
-    size_t n = 0;
     if (filtered && (IsEdgeFilterActive() || IsVertexFilterActive()))
-        run_action<>()(*this, lambda::var(n) =
-                       lambda::bind<size_t>(HardNumEdges(),lambda::_1))();
-    else
-        n = num_edges(*_mg);
-    return n;
+        return GetActiveEdges().size();
+    return num_edges(*_mg);
 }
 
 struct clear_vertices
@@ -24,6 +24,9 @@
 #include <boost/python/dict.hpp>
 
 #include <deque>
+#include <array>
+#include <atomic>
+#include <mutex>
 
 #include "graph_adjacency.hh"
 
@@ -48,7 +51,7 @@ namespace detail
 {
 // Generic graph_action functor. See graph_filtering.hh for details.
 template <class Action, class GraphViews, class Wrap = boost::mpl::false_,
-          class... TRS>
+          class ReleaseGIL = boost::mpl::false_, class... TRS>
 struct graph_action;
 }
 
@@ -80,6 +83,15 @@ public:
 
     size_t GetNumberOfVertices(bool filtered = true);
     size_t GetNumberOfEdges(bool filtered = true);
+
+    // indexes of the vertices and edges which are not filtered out, in
+    // increasing order
+    const vector<int64_t>& GetActiveVertices();
+    const vector<int64_t>& GetActiveEdges();
+
+    // signals that the values of boolean vertex (or edge) property maps may
+    // have been modified from python, which invalidates the cached lists
+    static void TouchFilterValues(bool edges);
     void SetDirected(bool directed) {_directed = directed;}
     bool GetDirected() {return _directed;}
     void SetReversed(bool reversed) {_reversed = reversed;}
@@ -97,6 +109,7 @@ public:
     // graph modification
     void InsertPropertyMap(string name, boost::any map);
     void ReIndexEdges();
+    void ShrinkToFit();
     void PurgeVertices(boost::any old_index); // removes filtered vertices
     void PurgeEdges();    // removes filtered edges
     void Clear();
@@ -155,6 +168,7 @@ public:
     vertex_index_map_t GetVertexIndex() {return _vertex_index;}
     edge_index_map_t   GetEdgeIndex()   {return _edge_index;}
     size_t             GetMaxEdgeIndex(){return _mg->get_last_index();}
+    size_t             GetStamp()       {return _mg->get_stamp();}
 
     graph_index_map_t  GetGraphIndex()  {return graph_index_map_t(0);}
 
@@ -164,7 +178,8 @@ public:
 private:
 
     // Generic graph_action functor. See graph_filtering.hh for details.
-    template <class Action, class GraphViews, class Wrap, class... TRS>
+    template <class Action, class GraphViews, class Wrap, class ReleaseGIL,
+              class... TRS>
     friend struct detail::graph_action;
 
     // python interface
@@ -204,6 +219,69 @@ private:
     edge_filter_t _edge_filter_map;
     bool _edge_filter_invert;
     bool _edge_filter_active;
+
+    // incremented whenever the filters are replaced
+    size_t _vertex_filter_version = 0;
+    size_t _edge_filter_version = 0;
+
+    // incremented whenever boolean property maps, which may be used as filters
+    // by any graph, are written from python
+    static std::atomic<size_t> _vertex_filter_writes;
+    static std::atomic<size_t> _edge_filter_writes;
+
+    // Counts and active index lists of the filtered graph. They are kept until
+    // the graph or the filters change, which is detected with the modification
+    // stamp of the graph and the version counters above. See
+    // graph_filtering.cc
+    struct filter_cache_t
+    {
+        filter_cache_t() {}
+        // copies of the graph start with an empty cache, and their own lock
+        filter_cache_t(const filter_cache_t&) {}
+        filter_cache_t& operator=(const filter_cache_t&)
+        {
+            has_vertices = has_edges = false;
+            return *this;
+        }
+
+        std::mutex lock;                // guards the lists against concurrent
+                                        // updates from different threads
+
+        bool has_vertices = false;
+        std::array<size_t, 3> vertex_key;
+        vector<int64_t> vertices;
+
+        bool has_edges = false;         // the edge list is computed on demand
+        std::array<size_t, 5> edge_key;
+        vector<int64_t> edges;
+    };
+    filter_cache_t _filter_cache;
+
+    void UpdateVertexCache();
+};
+
+// Releases the python global interpreter lock for as long as the object lives,
+// so that long-running code which does not touch python objects can proceed
+// concurrently with other python threads. Nothing is done if the calling thread
+// does not hold the lock, e.g. if it was already released further up.
+class GILRelease
+{
+public:
+    GILRelease(bool release = true)
+        : _state((release && PyGILState_Check()) ? PyEval_SaveThread()
+                                                 : nullptr) {}
+
+    ~GILRelease()
+    {
+        if (_state != nullptr)
+            PyEval_RestoreThread(_state);
+    }
+
+private:
+    GILRelease(const GILRelease&) = delete;
+    GILRelease& operator=(const GILRelease&) = delete;
+
+    PyThreadState* _state;
 };
 
 } //namespace graph_tool
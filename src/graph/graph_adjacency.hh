@@ -22,6 +22,7 @@
 #include <deque>
 #include <utility>
 #include <numeric>
+#include <algorithm>
 #include <iostream>
 #include <tuple>
 #include <boost/iterator.hpp>
@@ -34,6 +35,10 @@
 
 #include "transform_iterator.hh"
 
+#ifdef USING_OPENMP
+#include <omp.h>
+#endif
+
 namespace boost
 {
 
@@ -98,13 +103,26 @@ void remove_vertex(Vertex v, adj_list<Vertex>& g);
 template <class Vertex>
 void remove_vertex_fast(Vertex v, adj_list<Vertex>& g);
 
+template <class Vertex, class Mask>
+void remove_vertices(const Mask& deleted, adj_list<Vertex>& g);
+
 template <class Vertex>
 std::pair<typename adj_list<Vertex>::edge_descriptor, bool>
 add_edge(Vertex s, Vertex t, adj_list<Vertex>& g);
 
+template <class Vertex, class EdgeList>
+void add_edges(const EdgeList& es, adj_list<Vertex>& g);
+
+template <class Vertex, class DegList>
+void reserve_edges(const DegList& out_deg, const DegList& in_deg,
+                   adj_list<Vertex>& g);
+
 template <class Vertex>
 void remove_edge(Vertex s, Vertex t, adj_list<Vertex>& g);
 
+template <class Vertex, class Mask>
+void remove_edges(const Mask& deleted, adj_list<Vertex>& g);
+
 template <class Vertex>
 void remove_edge(const typename adj_list<Vertex>::edge_descriptor& e,
                  adj_list<Vertex>& g);
@@ -164,7 +182,7 @@ public:
     typedef std::vector<std::pair<vertex_t, vertex_t> > edge_list_t;
     typedef typename integer_range<Vertex>::iterator vertex_iterator;
 
-    adj_list(): _n_edges(0), _last_idx(0), _keep_epos(false) {}
+    adj_list(): _n_edges(0), _last_idx(0), _keep_epos(false), _stamp(0) {}
 
     struct get_vertex
     {
@@ -261,6 +279,7 @@ public:
 
     void reindex_edges()
     {
+        _stamp++;
         _free_indexes.clear();
         _last_idx = 0;
         _in_edges.clear();
@@ -300,6 +319,36 @@ public:
 
     size_t get_last_index() const { return _last_idx; }
 
+    // changes whenever the vertices or edges of the graph are modified, so that
+    // data derived from the graph structure can tell when it becomes stale
+    size_t get_stamp() const { return _stamp; }
+
+    // index which will be given to the i-th of the next edges to be added
+    size_t get_next_index(size_t i) const
+    {
+        if (i < _free_indexes.size())
+            return _free_indexes[i];
+        return _last_idx + (i - _free_indexes.size());
+    }
+
+    // releases the slack capacity left in the edge lists, e.g. after they
+    // were grown one edge at a time
+    void shrink_to_fit()
+    {
+        int i, N = _out_edges.size();
+        #pragma omp parallel for default(shared) private(i) \
+            schedule(runtime) if (N > 100)
+        for (i = 0; i < N; ++i)
+        {
+            _out_edges[i].shrink_to_fit();
+            _in_edges[i].shrink_to_fit();
+        }
+        _out_edges.shrink_to_fit();
+        _in_edges.shrink_to_fit();
+        _free_indexes.shrink_to_fit();
+        _epos.shrink_to_fit();
+    }
+
     static Vertex null_vertex() { return std::numeric_limits<Vertex>::max(); }
 
 private:
@@ -314,6 +363,7 @@ private:
                                       // memory use
     bool _keep_epos;
     std::vector<std::pair<int32_t, int32_t> > _epos;
+    size_t _stamp;                    // modification counter
 
     void rebuild_epos()
     {
@@ -369,12 +419,25 @@ private:
 
     friend void remove_vertex_fast<>(Vertex v, adj_list<Vertex>& g);
 
+    template <class V, class Mask>
+    friend void remove_vertices(const Mask& deleted, adj_list<V>& g);
+
     friend std::pair<edge_descriptor, bool>
     add_edge<>(Vertex s, Vertex t, adj_list<Vertex>& g);
 
+    template <class V, class EdgeList>
+    friend void add_edges(const EdgeList& es, adj_list<V>& g);
+
+    template <class V, class DegList>
+    friend void reserve_edges(const DegList& out_deg, const DegList& in_deg,
+                              adj_list<V>& g);
+
     friend void remove_edge<>(Vertex s, Vertex t, adj_list<Vertex>& g);
 
     friend void remove_edge<>(const edge_descriptor& e, adj_list<Vertex>& g);
+
+    template <class V, class Mask>
+    friend void remove_edges(const Mask& deleted, adj_list<V>& g);
 };
 
 //========================================================================
@@ -580,6 +643,7 @@ template <class Vertex>
 inline __attribute__((always_inline))
 Vertex add_vertex(adj_list<Vertex>& g)
 {
+    g._stamp++;
     size_t n = g._out_edges.size();
     g._out_edges.resize(n + 1);
     g._in_edges.resize(n + 1);
@@ -589,6 +653,7 @@ Vertex add_vertex(adj_list<Vertex>& g)
 template <class Vertex>
 inline void clear_vertex(Vertex v, adj_list<Vertex>& g)
 {
+    g._stamp++;
     if (!g._keep_epos)
     {
         auto& oes = g._out_edges[v];
@@ -665,6 +730,7 @@ inline void clear_vertex(Vertex v, adj_list<Vertex>& g)
 template <class Vertex>
 inline void remove_vertex(Vertex v, adj_list<Vertex>& g)
 {
+    g._stamp++;
     clear_vertex(v, g);
     g._out_edges.erase(g._out_edges.begin() + v);
     g._in_edges.erase(g._in_edges.begin() + v);
@@ -692,10 +758,112 @@ inline void remove_vertex(Vertex v, adj_list<Vertex>& g)
     }
 }
 
+// Removes every vertex v for which deleted[v] is true, together with its
+// edges. The remaining vertices keep their relative order, as with repeated
+// calls to remove_vertex() in decreasing index order, but the edge lists are
+// filtered and relabeled only once, in parallel. The indexes of the removed
+// edges are freed in the order in which they appear in the out-edge lists;
+// O(V + E)
+template <class Vertex, class Mask>
+inline void remove_vertices(const Mask& deleted, adj_list<Vertex>& g)
+{
+    g._stamp++;
+    size_t N = g._out_edges.size();
+
+    std::vector<Vertex> new_index(N);
+    size_t NN = 0;
+    for (size_t v = 0; v < N; ++v)
+    {
+        new_index[v] = NN;
+        if (!deleted[v])
+            NN++;
+    }
+
+    auto is_gone = [&](const std::pair<Vertex, Vertex>& e)
+        { return bool(deleted[e.first]); };
+
+    // number of removed out-edges of each vertex, as offsets into the list of
+    // free indexes
+    std::vector<size_t> nfree(N + 1, 0);
+
+    int i, NV = N;
+    #pragma omp parallel for default(shared) private(i) \
+        schedule(runtime) if (NV > 100)
+    for (i = 0; i < NV; ++i)
+    {
+        auto& oes = g._out_edges[i];
+        if (deleted[i])
+            nfree[i + 1] = oes.size();
+        else
+            nfree[i + 1] = std::count_if(oes.begin(), oes.end(), is_gone);
+    }
+
+    for (size_t v = 0; v < N; ++v)
+        nfree[v + 1] += nfree[v];
+
+    size_t F = g._free_indexes.size();
+    g._free_indexes.resize(F + nfree[N]);
+
+    #pragma omp parallel for default(shared) private(i) \
+        schedule(runtime) if (NV > 100)
+    for (i = 0; i < NV; ++i)
+    {
+        auto& oes = g._out_edges[i];
+        auto& ies = g._in_edges[i];
+        auto iter = g._free_indexes.begin() + F + nfree[i];
+        if (deleted[i])
+        {
+            for (auto& e : oes)
+                *(iter++) = e.second;
+            continue;
+        }
+
+        size_t k = 0;
+        for (auto& e : oes)
+        {
+            if (deleted[e.first])
+            {
+                *(iter++) = e.second;
+                continue;
+            }
+            oes[k] = e;
+            oes[k++].first = new_index[e.first];
+        }
+        oes.resize(k);
+
+        k = 0;
+        for (auto& e : ies)
+        {
+            if (deleted[e.first])
+                continue;
+            ies[k] = e;
+            ies[k++].first = new_index[e.first];
+        }
+        ies.resize(k);
+    }
+
+    g._n_edges -= nfree[N];
+
+    // new_index[v] <= v, so the lists can be moved down in place
+    for (size_t v = 0; v < N; ++v)
+    {
+        if (deleted[v] || new_index[v] == v)
+            continue;
+        g._out_edges[new_index[v]].swap(g._out_edges[v]);
+        g._in_edges[new_index[v]].swap(g._in_edges[v]);
+    }
+    g._out_edges.resize(NN);
+    g._in_edges.resize(NN);
+
+    if (g._keep_epos)
+        g.rebuild_epos();
+}
+
 // O(k + k_last)
 template <class Vertex>
 inline void remove_vertex_fast(Vertex v, adj_list<Vertex>& g)
 {
+    g._stamp++;
     clear_vertex(v, g);
     Vertex back = g._out_edges.size() - 1;
 
@@ -753,6 +921,7 @@ template <class Vertex>
 inline typename std::pair<typename adj_list<Vertex>::edge_descriptor, bool>
 add_edge(Vertex s, Vertex t, adj_list<Vertex>& g)
 {
+    g._stamp++;
     Vertex idx;
     if (g._free_indexes.empty())
     {
@@ -780,10 +949,124 @@ add_edge(Vertex s, Vertex t, adj_list<Vertex>& g)
     return std::make_pair(edge_descriptor(s, t, idx, false), true);
 }
 
+// Reserves the exact capacity needed to add out_deg[v] out-edges and in_deg[v]
+// in-edges to each vertex v, so that the edges can then be added one at a time
+// without any reallocation of the edge lists; O(V)
+template <class Vertex, class DegList>
+inline void reserve_edges(const DegList& out_deg, const DegList& in_deg,
+                          adj_list<Vertex>& g)
+{
+    int v, N = g._out_edges.size();
+    #pragma omp parallel for default(shared) private(v) \
+        schedule(runtime) if (N > 100)
+    for (v = 0; v < N; ++v)
+    {
+        auto& oes = g._out_edges[v];
+        oes.reserve(oes.size() + out_deg[v]);
+        auto& ies = g._in_edges[v];
+        ies.reserve(ies.size() + in_deg[v]);
+    }
+}
+
+// Bulk insertion of a list of (source, target) pairs. The result is identical
+// to repeated calls to add_edge(): the i-th edge receives the index
+// get_next_index(i), and the edges appear in the edge lists in the order of
+// the list. The list is split into contiguous chunks, and the edges of each
+// chunk are counted per vertex; an exclusive prefix sum of the counts over the
+// chunks then gives every chunk its own slots in each edge list, which are
+// grown once to their exact sizes and filled in parallel. The number of chunks
+// is bounded by E / V, so that the counts take O(E) memory; O(V + E)
+template <class Vertex, class EdgeList>
+inline void add_edges(const EdgeList& es, adj_list<Vertex>& g)
+{
+    g._stamp++;
+    size_t N = g._out_edges.size();
+    size_t E = es.size();
+
+    size_t C = 1;
+    if (E > 10000)
+    {
+#ifdef USING_OPENMP
+        C = omp_get_max_threads();
+#endif
+        C = std::max(size_t(1), std::min(C, (2 * E) / std::max(N, size_t(1))));
+    }
+
+    // counts of each (chunk, vertex) pair, later replaced by the position of
+    // the first slot of the chunk in the edge list of the vertex
+    std::vector<size_t> opos(C * N, 0), ipos(C * N, 0);
+
+    int c, NC = C;
+    #pragma omp parallel for default(shared) private(c) \
+        schedule(runtime) if (NC > 1)
+    for (c = 0; c < NC; ++c)
+    {
+        size_t* oc = opos.data() + c * N;
+        size_t* ic = ipos.data() + c * N;
+        for (size_t i = (E * c) / C; i < (E * (c + 1)) / C; ++i)
+        {
+            oc[es[i].first]++;
+            ic[es[i].second]++;
+        }
+    }
+
+    int v, NV = N;
+    #pragma omp parallel for default(shared) private(v) \
+        schedule(runtime) if (NV > 100 && NC > 1)
+    for (v = 0; v < NV; ++v)
+    {
+        auto& oes = g._out_edges[v];
+        auto& ies = g._in_edges[v];
+        size_t op = oes.size();
+        size_t ip = ies.size();
+        for (size_t j = 0; j < C; ++j)
+        {
+            size_t k = opos[j * N + v];
+            opos[j * N + v] = op;
+            op += k;
+            k = ipos[j * N + v];
+            ipos[j * N + v] = ip;
+            ip += k;
+        }
+        oes.reserve(op);
+        oes.resize(op);
+        ies.reserve(ip);
+        ies.resize(ip);
+    }
+
+    size_t F = std::min(E, g._free_indexes.size());
+    size_t base = g._last_idx;
+
+    #pragma omp parallel for default(shared) private(c) \
+        schedule(runtime) if (NC > 1)
+    for (c = 0; c < NC; ++c)
+    {
+        size_t* oc = opos.data() + c * N;
+        size_t* ic = ipos.data() + c * N;
+        for (size_t i = (E * c) / C; i < (E * (c + 1)) / C; ++i)
+        {
+            Vertex s = es[i].first;
+            Vertex t = es[i].second;
+            Vertex idx = (i < F) ? g._free_indexes[i] : base + (i - F);
+            g._out_edges[s][oc[s]++] = std::make_pair(t, idx);
+            g._in_edges[t][ic[t]++] = std::make_pair(s, idx);
+        }
+    }
+
+    g._free_indexes.erase(g._free_indexes.begin(),
+                          g._free_indexes.begin() + F);
+    g._last_idx += E - F;
+    g._n_edges += E;
+
+    if (g._keep_epos)
+        g.rebuild_epos();
+}
+
 template <class Vertex>
 inline void remove_edge(Vertex s, Vertex t,
                         adj_list<Vertex>& g)
 {
+    g._stamp++;
     if (!g._keep_epos)
     {
         auto& oes = g._out_edges[s];
@@ -814,6 +1097,7 @@ template <class Vertex>
 inline void remove_edge(const typename adj_list<Vertex>::edge_descriptor& e,
                         adj_list<Vertex>& g)
 {
+    g._stamp++;
     auto& s = e.s;
     auto& t = e.t;
     auto& idx = e.idx;
@@ -869,6 +1153,65 @@ inline void remove_edge(const typename adj_list<Vertex>::edge_descriptor& e,
 }
 
 
+// Removes every edge e for which deleted[idx] is true, where idx is the index
+// of e. Each edge list is compacted in place, in parallel, keeping the
+// relative order of the remaining edges. The indexes of the removed edges are
+// freed in the order in which they appear in the out-edge lists, as with
+// repeated calls to remove_edge() in that order; O(V + E)
+template <class Vertex, class Mask>
+inline void remove_edges(const Mask& deleted, adj_list<Vertex>& g)
+{
+    g._stamp++;
+    size_t N = g._out_edges.size();
+
+    auto is_gone = [&](const std::pair<Vertex, Vertex>& e)
+        { return bool(deleted[e.second]); };
+
+    // number of removed out-edges of each vertex, as offsets into the list of
+    // free indexes
+    std::vector<size_t> nfree(N + 1, 0);
+
+    int i, NV = N;
+    #pragma omp parallel for default(shared) private(i) \
+        schedule(runtime) if (NV > 100)
+    for (i = 0; i < NV; ++i)
+    {
+        auto& oes = g._out_edges[i];
+        nfree[i + 1] = std::count_if(oes.begin(), oes.end(), is_gone);
+    }
+
+    for (size_t v = 0; v < N; ++v)
+        nfree[v + 1] += nfree[v];
+
+    size_t F = g._free_indexes.size();
+    g._free_indexes.resize(F + nfree[N]);
+
+    #pragma omp parallel for default(shared) private(i) \
+        schedule(runtime) if (NV > 100)
+    for (i = 0; i < NV; ++i)
+    {
+        auto& oes = g._out_edges[i];
+        auto iter = g._free_indexes.begin() + F + nfree[i];
+        size_t k = 0;
+        for (auto& e : oes)
+        {
+            if (deleted[e.second])
+                *(iter++) = e.second;
+            else
+                oes[k++] = e;
+        }
+        oes.resize(k);
+
+        auto& ies = g._in_edges[i];
+        ies.erase(std::remove_if(ies.begin(), ies.end(), is_gone), ies.end());
+    }
+
+    g._n_edges -= nfree[N];
+
+    if (g._keep_epos)
+        g.rebuild_epos();
+}
+
 template <class Vertex>
 inline __attribute__((always_inline))
 Vertex source(const typename adj_list<Vertex>::edge_descriptor& e,
@@ -388,6 +388,13 @@ void ungroup_vector_property(GraphInterface& g, boost::any vector_prop,
                              boost::any prop, size_t pos, bool edge);
 void group_vector_property(GraphInterface& g, boost::any vector_prop,
                            boost::any prop, size_t pos, bool edge);
+boost::python::object ungroup_vector_array(GraphInterface& gi,
+                                           boost::any vector_prop,
+                                           boost::python::object opos,
+                                           bool edge);
+void group_vector_array(GraphInterface& gi, boost::any vector_prop,
+                        boost::python::object oa, boost::python::object opos,
+                        bool edge);
 void infect_vertex_property(GraphInterface& gi, boost::any prop,
                             boost::python::object val);
 void edge_endpoint(GraphInterface& gi, boost::any prop,
@@ -417,6 +424,7 @@ BOOST_PYTHON_MODULE(libgraph_tool_core)
     // random numbers
     class_<rng_t>("rng_t");
     def("get_rng", get_rng);
+    def("split_rng", split_rng);
 
     register_exception_translator<GraphException>
         (graph_exception_translator<GraphException>);
@@ -437,10 +445,10 @@ BOOST_PYTHON_MODULE(libgraph_tool_core)
     def("gcc_demangle", &python::detail::gcc_demangle);
 
     def("graph_filtering_enabled", &graph_filtering_enabled);
+    def("slim_dispatch_enabled", &slim_dispatch_enabled);
     export_openmp();
 
     boost::mpl::for_each<boost::mpl::push_back<scalar_types,string>::type>(export_vector_types());
-    boost::mpl::for_each<boost::mpl::vector<uint64_t>>(export_vector_types());
 
     class_<GraphInterface>("GraphInterface", init<>())
         .def(init<GraphInterface,bool,boost::python::object,
@@ -472,7 +480,9 @@ BOOST_PYTHON_MODULE(libgraph_tool_core)
         .def("GetVertexIndex", &GraphInterface::GetVertexIndex)
         .def("GetEdgeIndex", &GraphInterface::GetEdgeIndex)
         .def("GetMaxEdgeIndex", &GraphInterface::GetMaxEdgeIndex)
+        .def("GetStamp", &GraphInterface::GetStamp)
         .def("ReIndexEdges", &GraphInterface::ReIndexEdges)
+        .def("ShrinkToFit", &GraphInterface::ShrinkToFit)
         .def("GetGraphIndex", &GraphInterface::GetGraphIndex)
         .def("CopyVertexProperty", &GraphInterface::CopyVertexProperty)
         .def("CopyEdgeProperty", &GraphInterface::CopyEdgeProperty);
@@ -520,6 +530,8 @@ BOOST_PYTHON_MODULE(libgraph_tool_core)
 
     def("group_vector_property", &group_vector_property);
     def("ungroup_vector_property", &ungroup_vector_property);
+    def("group_vector_array", &group_vector_array);
+    def("ungroup_vector_array", &ungroup_vector_array);
     def("infect_vertex_property", &infect_vertex_property);
     def("edge_endpoint", &edge_endpoint);
     def("out_edges_op", &out_edges_op);
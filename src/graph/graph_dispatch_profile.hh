@@ -0,0 +1,74 @@
+// graph-tool -- a general graph modification and manipulation thingy
+//
+// Copyright (C) 2006-2015 Tiago de Paula Peixoto <tiago@skewed.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 3
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef GRAPH_DISPATCH_PROFILE_HH
+#define GRAPH_DISPATCH_PROFILE_HH
+
+#include <boost/mpl/vector.hpp>
+#include <boost/mpl/map.hpp>
+#include <boost/mpl/pair.hpp>
+#include <boost/python/object.hpp>
+
+#include <vector>
+#include <string>
+
+namespace graph_tool
+{
+
+// Slim dispatch profile
+// =====================
+//
+// Every algorithm called through run_action() is instantiated once for each
+// combination of graph view and property map types in its type lists. When
+// graph-tool is configured with --enable-slim-dispatch (which defines
+// GRAPH_TOOL_SLIM_DISPATCH), only the property maps with value types in
+// dispatch_value_types are instantiated. Property maps of the other value
+// types are converted at run time to maps of the corresponding type in
+// slim_value_types before the call, and the values changed by the algorithm
+// are converted back afterwards (see slim_conversion in graph_filtering.hh).
+// This trades a copy of the property values per call for smaller modules and
+// shorter compile times.
+//
+// Each value type in value_types which is not in dispatch_value_types must
+// have an entry in slim_value_types.
+
+#ifdef GRAPH_TOOL_SLIM_DISPATCH
+
+typedef boost::mpl::vector<uint8_t, int32_t, int64_t, double, std::string,
+                           std::vector<uint8_t>, std::vector<int32_t>,
+                           std::vector<int64_t>, std::vector<double>,
+                           std::vector<std::string>, boost::python::object>
+    dispatch_value_types;
+
+typedef boost::mpl::map<
+    boost::mpl::pair<int16_t, int32_t>,
+    boost::mpl::pair<uint32_t, int64_t>,
+    boost::mpl::pair<uint64_t, int64_t>,
+    boost::mpl::pair<float, double>,
+    boost::mpl::pair<long double, double>,
+    boost::mpl::pair<std::vector<int16_t>, std::vector<int32_t>>,
+    boost::mpl::pair<std::vector<uint32_t>, std::vector<int64_t>>,
+    boost::mpl::pair<std::vector<uint64_t>, std::vector<int64_t>>,
+    boost::mpl::pair<std::vector<float>, std::vector<double>>,
+    boost::mpl::pair<std::vector<long double>, std::vector<double>>>
+    slim_value_types;
+
+#endif
+
+} // graph_tool namespace
+
+#endif // GRAPH_DISPATCH_PROFILE_HH
@@ -18,6 +18,11 @@
 #include "graph_filtering.hh"
 #include <cxxabi.h>
 
+#ifdef GRAPH_TOOL_SLIM_DISPATCH
+#include <typeindex>
+#include <unordered_map>
+#endif
+
 using namespace graph_tool;
 using namespace graph_tool::detail;
 using namespace boost;
@@ -31,6 +36,157 @@ bool graph_tool::graph_filtering_enabled()
 #endif
 }
 
+bool graph_tool::slim_dispatch_enabled()
+{
+#ifdef GRAPH_TOOL_SLIM_DISPATCH
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef GRAPH_TOOL_SLIM_DISPATCH
+
+// value conversion between a type and its slim counterpart
+template <class To>
+struct slim_cast
+{
+    template <class From>
+    To operator()(const From& v) const { return To(v); }
+};
+
+template <class To>
+struct slim_cast<vector<To>>
+{
+    template <class From>
+    vector<To> operator()(const vector<From>& v) const
+    {
+        return vector<To>(v.begin(), v.end());
+    }
+};
+
+typedef std::function<boost::any(const boost::any&,
+                                 vector<std::function<void()>>&)>
+    slim_converter_t;
+
+template <class Value, class Slim, class IndexMap>
+struct slim_map_conversion
+{
+    typedef typename property_map_type::apply<Value, IndexMap>::type map_t;
+    typedef typename property_map_type::apply<Slim, IndexMap>::type slim_map_t;
+
+    static slim_map_t convert(map_t pmap,
+                              vector<std::function<void()>>& write_back)
+    {
+        slim_map_t smap((IndexMap()));
+        auto& src = pmap.get_storage();
+        auto& dst = smap.get_storage();
+        dst.resize(src.size());
+        int i, N = src.size();
+        #pragma omp parallel for default(shared) private(i) \
+            schedule(runtime) if (N > 100)
+        for (i = 0; i < N; ++i)
+            dst[i] = slim_cast<Slim>()(src[i]);
+
+        // only the values which were modified are converted back, so that the
+        // other ones do not suffer a lossy round trip
+        write_back.push_back([=] ()
+            {
+                auto& src = pmap.get_storage();
+                auto& dst = smap.get_storage();
+                if (src.size() < dst.size())
+                    src.resize(dst.size());
+                int i, N = dst.size();
+                #pragma omp parallel for default(shared) private(i) \
+                    schedule(runtime) if (N > 100)
+                for (i = 0; i < N; ++i)
+                {
+                    if (slim_cast<Slim>()(src[i]) != dst[i])
+                        src[i] = slim_cast<Value>()(dst[i]);
+                }
+            });
+        return smap;
+    }
+};
+
+struct add_slim_converters
+{
+    typedef std::unordered_map<std::type_index, slim_converter_t> table_t;
+
+    add_slim_converters(table_t& table): _table(table) {}
+
+    template <class Pair>
+    void operator()(Pair) const
+    {
+        typedef typename Pair::first value_t;
+        typedef typename Pair::second slim_t;
+        add<value_t, slim_t, GraphInterface::vertex_index_map_t>();
+        add<value_t, slim_t, GraphInterface::edge_index_map_t>();
+    }
+
+    template <class Value, class Slim, class IndexMap>
+    void add() const
+    {
+        typedef slim_map_conversion<Value, Slim, IndexMap> conv_t;
+        typedef typename conv_t::map_t map_t;
+        typedef typename conv_t::slim_map_t slim_map_t;
+
+        _table[std::type_index(typeid(map_t))] =
+            [] (const boost::any& a, vector<std::function<void()>>& wb)
+            {
+                return boost::any(conv_t::convert(any_cast<map_t>(a), wb));
+            };
+        _table[std::type_index(typeid(scalarS<map_t>))] =
+            [] (const boost::any& a, vector<std::function<void()>>& wb)
+            {
+                auto pmap = any_cast<scalarS<map_t>>(a)._pmap;
+                return boost::any(scalarS<slim_map_t>(conv_t::convert(pmap,
+                                                                      wb)));
+            };
+    }
+
+    table_t& _table;
+};
+
+boost::any graph_tool::detail::slim_conversion::convert(const boost::any& a)
+{
+    static add_slim_converters::table_t table =
+        [] ()
+        {
+            add_slim_converters::table_t table;
+            boost::mpl::for_each<slim_value_types>(add_slim_converters(table));
+            return table;
+        }();
+
+    auto iter = table.find(std::type_index(a.type()));
+    if (iter == table.end())
+        return a;
+    return iter->second(a, _write_back);
+}
+
+void graph_tool::detail::slim_conversion::write_back()
+{
+    // the list is emptied first, so that nothing is written twice if one of
+    // the conversions throws
+    vector<std::function<void()>> write_back;
+    write_back.swap(_write_back);
+    for (auto& f : write_back)
+        f();
+}
+
+graph_tool::detail::slim_conversion::~slim_conversion()
+{
+    // there are pending values only if the action threw; the exception being
+    // propagated takes precedence over any error raised here
+    try
+    {
+        write_back();
+    }
+    catch (...) {}
+}
+
+#endif
+
 string name_demangle(string name)
 {
     int status = 0;
@@ -197,6 +353,12 @@ void GraphInterface::ReIndexEdges()
     _mg->reindex_edges();
 }
 
+// this will release the unused capacity of the edge lists
+void GraphInterface::ShrinkToFit()
+{
+    _mg->shrink_to_fit();
+}
+
 // this will definitively remove all the edges from the graph, which are being
 // currently filtered out. This will also disable the edge filter
 void GraphInterface::PurgeEdges()
@@ -205,19 +367,19 @@ void GraphInterface::PurgeEdges()
         return;
 
     MaskFilter<edge_filter_t> filter(_edge_filter_map, _edge_filter_invert);
-    graph_traits<multigraph_t>::vertex_iterator v, v_end;
-    graph_traits<multigraph_t>::out_edge_iterator e, e_end;
-    vector<graph_traits<multigraph_t>::edge_descriptor> deleted_edges;
-    for (tie(v, v_end) = vertices(*_mg); v != v_end; ++v)
+    vector<uint8_t> deleted(_mg->get_last_index(), false);
+
+    int i, N = num_vertices(*_mg);
+    #pragma omp parallel for default(shared) private(i) \
+        schedule(runtime) if (N > 100)
+    for (i = 0; i < N; ++i)
     {
-        for (tie(e, e_end) = out_edges(*v, *_mg); e != e_end; ++e)
-            if (!filter(*e))
-                deleted_edges.push_back(*e);
-        for (typeof(deleted_edges.begin()) iter = deleted_edges.begin();
-             iter != deleted_edges.end(); ++iter)
-            remove_edge(*iter, *_mg);
-        deleted_edges.clear();
+        graph_traits<multigraph_t>::out_edge_iterator e, e_end;
+        for (tie(e, e_end) = out_edges(vertex(i, *_mg), *_mg); e != e_end; ++e)
+            deleted[_edge_index[*e]] = !filter(*e);
     }
+
+    remove_edges(deleted, *_mg);
 }
 
 
@@ -228,7 +390,7 @@ void GraphInterface::PurgeVertices(boost::any aold_index)
     if (!IsVertexFilterActive())
         return;
 
-    typedef property_map_type::apply<int32_t,
+    typedef property_map_type::apply<int64_t,
                                      GraphInterface::vertex_index_map_t>::type
         index_prop_t;
     index_prop_t old_index = any_cast<index_prop_t>(aold_index);
@@ -239,29 +401,14 @@ void GraphInterface::PurgeVertices(boost::any aold_index)
     vector<bool> deleted(N, false);
     for (size_t i = 0; i < N; ++i)
         deleted[i] = !filter(vertex(i, *_mg));
-    vector<int> old_indexes;
 
-    vector<graph_traits<multigraph_t>::edge_descriptor> edges;
+    remove_vertices(deleted, *_mg);
 
-    //remove vertices
-    for (int i = N-1; i >= 0; --i)
-    {
-        if (deleted[i])
-        {
-            graph_traits<multigraph_t>::vertex_descriptor v =
-                vertex(i, *_mg);
-            remove_vertex(v, *_mg);
-        }
-        else
-        {
-            old_indexes.push_back(i);
-        }
-    }
-
-    N = old_indexes.size();
-    for (int i = N-1; i >= 0; --i)
+    size_t pos = 0;
+    for (size_t i = 0; i < N; ++i)
     {
-        old_index[vertex((N - 1) - i, *_mg)] = old_indexes[i];
+        if (!deleted[i])
+            old_index[vertex(pos++, *_mg)] = i;
     }
 }
 
@@ -273,6 +420,7 @@ void GraphInterface::SetVertexFilterProperty(boost::any property, bool invert)
 
     try
     {
+        _vertex_filter_version++;
         _vertex_filter_map =
             any_cast<vertex_filter_t::checked_t>(property).get_unchecked();
         _vertex_filter_invert = invert;
@@ -294,6 +442,7 @@ void GraphInterface::SetEdgeFilterProperty(boost::any property, bool invert)
 
     try
     {
+        _edge_filter_version++;
         _edge_filter_map =
             any_cast<edge_filter_t::checked_t>(property).get_unchecked();
         _edge_filter_invert = invert;
@@ -306,3 +455,102 @@ void GraphInterface::SetEdgeFilterProperty(boost::any property, bool invert)
         _edge_filter_active = false;
     }
 }
+
+std::atomic<size_t> GraphInterface::_vertex_filter_writes(0);
+std::atomic<size_t> GraphInterface::_edge_filter_writes(0);
+
+void GraphInterface::TouchFilterValues(bool edges)
+{
+    if (edges)
+        _edge_filter_writes++;
+    else
+        _vertex_filter_writes++;
+}
+
+// recomputes the cached list of active vertices, if the graph or the vertex
+// filter changed since it was last computed; O(1) if the list is still valid.
+// This must be called with the cache lock held
+void GraphInterface::UpdateVertexCache()
+{
+    auto& c = _filter_cache;
+    std::array<size_t, 3> key = {{_mg->get_stamp(), _vertex_filter_version,
+                                  _vertex_filter_writes}};
+    if (c.has_vertices && c.vertex_key == key)
+        return;
+
+    size_t N = num_vertices(*_mg);
+    c.vertices.clear();
+    if (_vertex_filter_active)
+    {
+        _vertex_filter_map.reserve(N);
+        MaskFilter<vertex_filter_t> filter(_vertex_filter_map,
+                                           _vertex_filter_invert);
+        c.vertices.reserve(filter.count(N));
+        for (size_t v = filter.find_next(0, N); v < N;
+             v = filter.find_next(v + 1, N))
+            c.vertices.push_back(v);
+    }
+    else
+    {
+        c.vertices.resize(N);
+        for (size_t v = 0; v < N; ++v)
+            c.vertices[v] = v;
+    }
+    c.vertex_key = key;
+    c.has_vertices = true;
+}
+
+const vector<int64_t>& GraphInterface::GetActiveVertices()
+{
+    std::lock_guard<std::mutex> lock(_filter_cache.lock);
+    UpdateVertexCache();
+    return _filter_cache.vertices;
+}
+
+const vector<int64_t>& GraphInterface::GetActiveEdges()
+{
+    std::lock_guard<std::mutex> lock(_filter_cache.lock);
+    UpdateVertexCache();
+    auto& c = _filter_cache;
+    std::array<size_t, 5> key = {{c.vertex_key[0], c.vertex_key[1],
+                                  c.vertex_key[2], _edge_filter_version,
+                                  _edge_filter_writes}};
+    if (c.has_edges && c.edge_key == key)
+        return c.edges;
+
+    if (_edge_filter_active)
+        _edge_filter_map.reserve(_mg->get_last_index());
+    MaskFilter<vertex_filter_t> vfilter(_vertex_filter_map,
+                                        _vertex_filter_invert);
+    MaskFilter<edge_filter_t> efilter(_edge_filter_map, _edge_filter_invert);
+    bool vactive = _vertex_filter_active;
+    bool eactive = _edge_filter_active;
+
+    // the edges are marked by index, and the marks are then collected in order
+    vector<uint8_t> active(_mg->get_last_index(), false);
+    auto& g = *_mg;
+    const auto& vs = c.vertices;
+    int i, N = vs.size();
+    #pragma omp parallel for default(shared) private(i) \
+        schedule(runtime) if (N > 100)
+    for (i = 0; i < N; ++i)
+    {
+        graph_traits<multigraph_t>::out_edge_iterator e, e_end;
+        for (tie(e, e_end) = out_edges(vertex(vs[i], g), g); e != e_end; ++e)
+        {
+            if (vactive && !vfilter(target(*e, g)))
+                continue;
+            if (eactive && !efilter(*e))
+                continue;
+            active[_edge_index[*e]] = true;
+        }
+    }
+
+    c.edges.clear();
+    for (size_t idx = 0; idx < active.size(); ++idx)
+        if (active[idx])
+            c.edges.push_back(idx);
+    c.edge_key = key;
+    c.has_edges = true;
+    return c.edges;
+}
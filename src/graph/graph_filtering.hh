@@ -22,6 +22,7 @@
 #include <boost/version.hpp>
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/filtered_graph.hpp>
+#include <boost/range/irange.hpp>
 #if (BOOST_VERSION / 100 % 1000 >= 48)
     #include <boost/graph/reverse_graph_alt.hpp>
 #else
@@ -53,8 +54,17 @@
 #include "graph_selectors.hh"
 #include "graph_util.hh"
 #include "mpl_nested_loop.hh"
+#include "graph_dispatch_profile.hh"
+
+#ifdef GRAPH_TOOL_SLIM_DISPATCH
+#include <boost/mpl/remove_if.hpp>
+#include <boost/mpl/contains.hpp>
+#include <boost/mpl/back_inserter.hpp>
+#include <functional>
+#endif
 
 #include <type_traits>
+#include <cstring>
 
 namespace graph_tool
 {
@@ -109,6 +119,9 @@ namespace graph_tool
 //
 // The above line will run my_algorithm::operator() with Graph being the
 // appropriate graph view type and ValueType being 'double' and val = 42.0.
+//
+// Algorithms which do not touch python objects can be called instead with
+// run_action_nogil(), which releases the python GIL while they run.
 
 // Whenever no implementation is called, the following exception is thrown
 class ActionNotFound: public GraphException
@@ -157,7 +170,55 @@ public:
         //       as possible.
     }
 
+    // The functions below work directly on the contiguous mask storage, and
+    // are meant for vertex filters, where each descriptor is its own index.
+    // The mask is read one 64-bit word (eight entries) at a time, so that
+    // long stretches of masked vertices are skipped in bulk.
+
+    // returns the first position in [pos, end) which is not masked, or end
+    size_t find_next(size_t pos, size_t end) const
+    {
+        const uint8_t* mask = _filtered_property.get_storage().data();
+        for (; pos < end && pos % 8 != 0; ++pos)
+            if (bool(mask[pos]) != _invert)
+                return pos;
+        uint64_t masked = _invert ? high_bits : 0;
+        for (; pos + 8 <= end; pos += 8)
+        {
+            if (nonzero_bytes(mask + pos) != masked)
+                break;
+        }
+        for (; pos < end; ++pos)
+            if (bool(mask[pos]) != _invert)
+                return pos;
+        return end;
+    }
+
+    // returns the number of positions in [0, end) which are not masked
+    size_t count(size_t end) const
+    {
+        const uint8_t* mask = _filtered_property.get_storage().data();
+        size_t n = 0, pos = 0;
+        for (; pos + 8 <= end; pos += 8)
+            n += __builtin_popcountll(nonzero_bytes(mask + pos));
+        for (; pos < end; ++pos)
+            n += bool(mask[pos]);
+        return _invert ? end - n : n;
+    }
+
 private:
+    static constexpr uint64_t high_bits = 0x8080808080808080ULL;
+    static constexpr uint64_t low_bits = 0x7f7f7f7f7f7f7f7fULL;
+
+    // sets the highest bit of each byte of the word which is nonzero, and
+    // clears all the others
+    static uint64_t nonzero_bytes(const uint8_t* mask)
+    {
+        uint64_t w;
+        memcpy(&w, mask, sizeof(w));
+        return (((w & low_bits) + low_bits) | w) & high_bits;
+    }
+
     DescriptorProperty _filtered_property;
     bool _invert;
 };
@@ -400,9 +461,37 @@ BOOST_MPL_ASSERT_RELATION(n_views::value, == , boost::mpl::int_<3>::value);
 // run_action() implementation
 // ===========================
 
+// whether a type holds python objects, i.e. python::object values or property
+// maps of them
+template <class T>
+struct holds_python: std::is_same<T, boost::python::object> {};
+
+template <class T>
+struct holds_python<std::vector<T>>: holds_python<T> {};
+
+template <class Value, class IndexMap>
+struct holds_python<boost::checked_vector_property_map<Value, IndexMap>>
+    : holds_python<Value> {};
+
+template <class Value, class IndexMap>
+struct holds_python<boost::unchecked_vector_property_map<Value, IndexMap>>
+    : holds_python<Value> {};
+
+template <class PropertyMap>
+struct holds_python<scalarS<PropertyMap>>: holds_python<PropertyMap> {};
+
+template <class... Ts>
+struct any_holds_python: std::false_type {};
+
+template <class T, class... Ts>
+struct any_holds_python<T, Ts...>
+    : std::integral_constant<bool, (holds_python<T>::value ||
+                                    any_holds_python<Ts...>::value)> {};
+
 // wrap action to be called, to deal with property maps, i.e., return version
-// with no bounds checking.
-template <class Action, class Wrap>
+// with no bounds checking. If ReleaseGIL is true, the python GIL is released
+// while the action runs, unless one of the arguments holds python objects.
+template <class Action, class Wrap, class ReleaseGIL = boost::mpl::false_>
 struct action_wrap
 {
     action_wrap(Action a, GraphInterface& g, size_t max_v, size_t max_e)
@@ -455,13 +544,17 @@ struct action_wrap
     void operator()() const {};
 
     template <class T1> void operator()(T1* a1) const
-    { _a(*a1); }
+    {
+        GILRelease gil_release(ReleaseGIL::value);
+        _a(*a1);
+    }
 
     template <class T1, class... Ts>
     void operator()(T1* a1, Ts&&... as) const
     {
+        typedef any_holds_python<typename std::decay<Ts>::type...> has_python;
+        GILRelease gil_release(ReleaseGIL::value && !has_python::value);
         _a(*a1, uncheck(std::forward<Ts>(as), Wrap())...);
-
     }
 
     Action _a;
@@ -469,9 +562,60 @@ struct action_wrap
     size_t _max_v, _max_e;
 };
 
+#ifdef GRAPH_TOOL_SLIM_DISPATCH
+
+// whether a type in a run_action() type list is instantiated in the slim
+// dispatch profile (see graph_dispatch_profile.hh)
+template <class T>
+struct in_dispatch_profile: boost::mpl::true_ {};
+
+template <class Value, class IndexMap>
+struct in_dispatch_profile<boost::checked_vector_property_map<Value, IndexMap>>
+    : boost::mpl::contains<dispatch_value_types, Value>::type {};
+
+template <class PropertyMap>
+struct in_dispatch_profile<scalarS<PropertyMap>>
+    : in_dispatch_profile<PropertyMap> {};
+
+// removes from a type list the types which are not in the dispatch profile
+template <class TR>
+struct dispatch_types
+{
+    typedef typename boost::mpl::remove_if<
+        TR, boost::mpl::not_<in_dispatch_profile<boost::mpl::_1>>,
+        boost::mpl::back_inserter<boost::mpl::vector<>>>::type type;
+};
+
+// this converts the property maps passed to run_action() which are not in the
+// dispatch profile to maps of the corresponding slim types, and writes the
+// values modified by the action back to the original maps. Pending values are
+// also written back when the object is destroyed, so that the original maps
+// see the modifications made before an exception thrown by the action, as
+// they would without the conversion
+class slim_conversion
+{
+public:
+    slim_conversion() {}
+    ~slim_conversion();
+    boost::any convert(const boost::any& a);
+    void write_back();
+
+    template <class T>
+    T convert(const T& a) { return a; }
+
+private:
+    slim_conversion(const slim_conversion&) = delete;
+    slim_conversion& operator=(const slim_conversion&) = delete;
+
+    vector<std::function<void()>> _write_back;
+};
+
+#endif
+
 // this functor encapsulates another functor Action, which takes a pointer to a
 // graph view as first argument
-template <class Action, class GraphViews, class Wrap, class... TRS>
+template <class Action, class GraphViews, class Wrap, class ReleaseGIL,
+          class... TRS>
 struct graph_action
 {
     struct graph_view_pointers:
@@ -484,10 +628,17 @@ struct graph_action
     template <class... Args>
     void operator()(Args&&... args) const
     {
-        bool found = false;
         boost::any gview = _g.GetGraphView();
-        boost::mpl::nested_for_each<graph_view_pointers,TRS...>
-            (boost::mpl::select_types(_a, found, gview, std::forward<Args>(args)...));
+#ifndef GRAPH_TOOL_SLIM_DISPATCH
+        bool found = boost::mpl::cached_nested_dispatch
+            <graph_view_pointers,TRS...>(_a, gview, std::forward<Args>(args)...);
+#else
+        slim_conversion conv;
+        bool found = boost::mpl::cached_nested_dispatch
+            <graph_view_pointers,typename dispatch_types<TRS>::type...>
+            (_a, gview, conv.convert(args)...);
+        conv.write_back();
+#endif
         if (!found)
         {
             vector<const std::type_info*> args_t = {(&(args).type())...};
@@ -496,26 +647,107 @@ struct graph_action
     }
 
     const GraphInterface &_g;
-    action_wrap<Action, Wrap> _a;
+    action_wrap<Action, Wrap, ReleaseGIL> _a;
 };
 } // details namespace
 
 
 // all definitions of run_action with different arity
-template <class GraphViews = detail::all_graph_views, class Wrap = boost::mpl::false_>
+template <class GraphViews = detail::all_graph_views, class Wrap = boost::mpl::false_,
+          class ReleaseGIL = boost::mpl::false_>
 struct run_action
 {
     template <class Action, class... TRS>
-    detail::graph_action<Action,GraphViews,Wrap,TRS...>
+    detail::graph_action<Action,GraphViews,Wrap,ReleaseGIL,TRS...>
     operator()(GraphInterface &g, Action&& a, TRS...)
     {
-        return detail::graph_action<Action,GraphViews,Wrap,TRS...>(g, std::forward<Action>(a));
+        return detail::graph_action<Action,GraphViews,Wrap,ReleaseGIL,TRS...>
+            (g, std::forward<Action>(a));
     }
 };
 
+// same as run_action, but the python GIL is released while the action runs, so
+// that other python threads can proceed. The GIL is kept if any of the
+// dispatched arguments holds python objects (e.g. a python::object property
+// map), but this check cannot see the arguments bound into the action itself,
+// e.g. with std::bind(). Therefore the caller must guarantee that:
+//
+//  - no argument bound into the action is, or holds, a python object
+//    (python::object, python::list, a python::object property map, ...), or
+//    a function which calls into python;
+//
+//  - the action does not create, copy or destroy python objects, nor raise
+//    python exceptions, e.g. by returning values through python::object.
+//
+// Bound boost::any values are fine if the action only casts them to types
+// which satisfy the above. If in doubt, use run_action.
+template <class GraphViews = detail::all_graph_views, class Wrap = boost::mpl::false_>
+struct run_action_nogil: public run_action<GraphViews, Wrap, boost::mpl::true_> {};
+
 // returns true if graph filtering was enabled at compile time
 bool graph_filtering_enabled();
 
+// returns true if the slim dispatch profile was enabled at compile time
+bool slim_dispatch_enabled();
+
 } //graph_tool namespace
 
+// The vertices of a filtered graph are iterated through with a filter_iterator
+// over the vertex indexes, which by default tests the predicate for every
+// vertex, masked or not. This specialization uses MaskFilter::find_next()
+// instead, which skips masked vertices eight at a time.
+namespace boost { namespace iterators
+{
+template <class DescriptorProperty, class Vertex>
+class filter_iterator<graph_tool::detail::MaskFilter<DescriptorProperty>,
+                      range_detail::integer_iterator<Vertex>>
+    : public detail::filter_iterator_base
+        <graph_tool::detail::MaskFilter<DescriptorProperty>,
+         range_detail::integer_iterator<Vertex>>::type
+{
+    typedef graph_tool::detail::MaskFilter<DescriptorProperty> Predicate;
+    typedef range_detail::integer_iterator<Vertex> Iterator;
+    typedef typename detail::filter_iterator_base<Predicate, Iterator>::type
+        super_t;
+
+    friend class iterator_core_access;
+
+public:
+    filter_iterator() {}
+
+    filter_iterator(Predicate f, Iterator x, Iterator end_ = Iterator())
+        : super_t(x), m_predicate(f), m_end(end_)
+    {
+        satisfy_predicate();
+    }
+
+    Predicate predicate() const { return m_predicate; }
+
+    Iterator end() const { return m_end; }
+
+private:
+    void increment()
+    {
+        ++(this->base_reference());
+        satisfy_predicate();
+    }
+
+    void decrement()
+    {
+        while (!this->m_predicate(*--(this->base_reference()))) {};
+    }
+
+    void satisfy_predicate()
+    {
+        Vertex v = *this->base();
+        Vertex end = *m_end;
+        if (v < end)
+            this->base_reference() = Iterator(m_predicate.find_next(v, end));
+    }
+
+    Predicate m_predicate;
+    Iterator m_end;
+};
+}} // boost::iterators namespace
+
 #endif // FILTERING_HH
@@ -203,17 +203,31 @@ void read_adjacency_dispatch(Graph& g, size_t N, std::istream& s)
 {
     typedef typename graph_traits<Graph>::vertex_descriptor vertex_t;
 
+    // the lists are read first, so that the edge lists of the graph can be
+    // allocated with their exact sizes
+    std::vector<std::vector<Vint>> uss(N);
+    std::vector<size_t> out_deg(N), in_deg(N, 0);
     for (vertex_t v = 0; v < N; ++v)
     {
-        std::vector<Vint> us;
+        auto& us = uss[v];
         read<BE>(s, us);
+        out_deg[v] = us.size();
         for (vertex_t u : us)
         {
             if (u >= N)
                 throw IOException("error reading graph: vertex index not in range");
-            add_edge(v, u, g);
+            in_deg[u]++;
         }
     }
+
+    reserve_edges(out_deg, in_deg, g);
+
+    for (vertex_t v = 0; v < N; ++v)
+    {
+        for (vertex_t u : uss[v])
+            add_edge(v, u, g);
+        std::vector<Vint>().swap(uss[v]);
+    }
 }
 
 
@@ -252,9 +266,6 @@ enum class property_type : uint8_t
 
 using namespace boost;
 
-typedef mpl::joint_view<value_types,
-                        mpl::vector<size_t>>::type val_types;
-
 struct graph_range_traits
 {
     typedef GraphInterface::graph_index_map_t index_map_t;
@@ -314,8 +325,8 @@ struct write_property_dispatch
         {
             typedef typename property_map_type::apply<T, typename RangeTraits::index_map_t>::type pmap_t;
             pmap_t prop = any_cast<pmap_t>(aprop);
-            typedef typename mpl::find<val_types, T>::type pos;
-            uint8_t val = mpl::distance<typename mpl::begin<val_types>::type, pos>::type::value;
+            typedef typename mpl::find<value_types, T>::type pos;
+            uint8_t val = mpl::distance<typename mpl::begin<value_types>::type, pos>::type::value;
             write(s, val);
             for (auto x : RangeTraits::get_range(g))
                 write(s, prop[x]);
@@ -324,17 +335,17 @@ struct write_property_dispatch
         catch (const boost::bad_any_cast&) {}
     }
 
-
+    // index maps are not value types, and are written as int64_t
     template <class Graph>
-    void operator()(size_t, Graph& g, boost::any& aprop, bool& found,
-                    std::ostream& s) const
+    void write_index(Graph& g, boost::any& aprop, bool& found,
+                     std::ostream& s) const
     {
         try
         {
             typedef GraphInterface::vertex_index_map_t pmap_t;
             pmap_t prop = any_cast<pmap_t>(aprop);
-            typedef typename mpl::find<val_types, int64_t>::type pos;
-            uint8_t val = mpl::distance<typename mpl::begin<val_types>::type, pos>::type::value;
+            typedef typename mpl::find<value_types, int64_t>::type pos;
+            uint8_t val = mpl::distance<typename mpl::begin<value_types>::type, pos>::type::value;
             write(s, val);
             int64_t y;
             for (auto x : vertices_range(g))
@@ -350,8 +361,8 @@ struct write_property_dispatch
         {
             typedef GraphInterface::edge_index_map_t pmap_t;
             pmap_t prop = any_cast<pmap_t>(aprop);
-            typedef typename mpl::find<val_types, int64_t>::type pos;
-            uint8_t val = mpl::distance<typename mpl::begin<val_types>::type, pos>::type::value;
+            typedef typename mpl::find<value_types, int64_t>::type pos;
+            uint8_t val = mpl::distance<typename mpl::begin<value_types>::type, pos>::type::value;
             write(s, val);
             int64_t y;
             for (auto x : edges_range(g))
@@ -374,10 +385,12 @@ void write_property(Graph& g, std::string& name, boost::any& prop, std::ostream&
     write(s, pt);
     write(s, name);
     bool found = false;
-    mpl::for_each<val_types>(std::bind(write_property_dispatch<RangeTraits>(),
-                                       std::placeholders::_1, std::ref(g),
-                                       std::ref(prop), std::ref(found),
-                                       std::ref(s)));
+    mpl::for_each<value_types>(std::bind(write_property_dispatch<RangeTraits>(),
+                                         std::placeholders::_1, std::ref(g),
+                                         std::ref(prop), std::ref(found),
+                                         std::ref(s)));
+    if (!found)
+        write_property_dispatch<RangeTraits>().write_index(g, prop, found, s);
     if (!found)
         throw GraphException("Error writing graph: unknown property map type (this is a bug)");
 }
@@ -390,8 +403,8 @@ struct read_property_dispatch
     void operator()(T, Graph& g, boost::any& aprop, uint8_t val, bool ignore,
                     bool& found, std::istream& s) const
     {
-        typedef typename mpl::find<val_types, T>::type pos;
-        if (mpl::distance<typename mpl::begin<val_types>::type, pos>::type::value == val)
+        typedef typename mpl::find<value_types, T>::type pos;
+        if (mpl::distance<typename mpl::begin<value_types>::type, pos>::type::value == val)
         {
             typedef typename property_map_type::apply<T, typename RangeTraits::index_map_t>::type pmap_t;
             pmap_t prop(RangeTraits::get_index_map(g));
@@ -427,10 +440,10 @@ read_property(Graph& g, const std::unordered_set<std::string>& ignore,
     bool skip = ignore.find(name) != ignore.end();
     uint8_t val = 0;
     read<BE>(s, val);
-    mpl::for_each<val_types>(std::bind(read_property_dispatch<BE, RangeTraits>(),
-                                       std::placeholders::_1, std::ref(g),
-                                       std::ref(prop), val, skip, std::ref(found),
-                                       std::ref(s)));
+    mpl::for_each<value_types>(std::bind(read_property_dispatch<BE, RangeTraits>(),
+                                         std::placeholders::_1, std::ref(g),
+                                         std::ref(prop), val, skip, std::ref(found),
+                                         std::ref(s)));
     if (!found)
         throw IOException("Error reading graph: invalid property value type index "
                           + boost::lexical_cast<std::string>(val));
@@ -40,7 +40,8 @@ const char* type_names[] =
     {"bool", "int16_t", "int32_t", "int64_t", "double", "long double",
      "string", "vector<bool>", "vector<int16_t>", "vector<int32_t>",
      "vector<int64_t>", "vector<double>", "vector<long double>",
-     "vector<string>", "python::object"};
+     "vector<string>", "python::object", "float32_t", "uint32_t", "uint64_t",
+     "vector<float32_t>", "vector<uint32_t>", "vector<uint64_t>"};
 
 
 struct shift_vertex_property
@@ -52,12 +53,18 @@ struct shift_vertex_property
         try
         {
             PropertyMap pmap = any_cast<PropertyMap>(map);
-            size_t back = num_vertices(g) - 1;
+            size_t N = num_vertices(g);
+            vector<bool> deleted(N, false);
             for (auto v : vi)
+                deleted[v] = true;
+            size_t pos = 0;
+            for (size_t i = 0; i < N; ++i)
             {
-                for (size_t i = v; i < back; ++i)
-                    pmap[vertex(i, g)] = pmap[vertex(i + 1, g)];
-                back--;
+                if (deleted[i])
+                    continue;
+                if (pos != i)
+                    pmap[vertex(pos, g)] = pmap[vertex(i, g)];
+                pos++;
             }
             found = true;
         }
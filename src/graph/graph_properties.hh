@@ -40,6 +40,7 @@
 #endif
 #include "fast_vector_property_map.hh"
 #include <boost/mpl/vector.hpp>
+#include <boost/mpl/vector/vector30.hpp>
 #include <boost/mpl/for_each.hpp>
 #include <boost/mpl/transform.hpp>
 #include <boost/mpl/find.hpp>
@@ -65,24 +66,33 @@ using namespace std;
 //       broken, and use a vector<uint8_t> instead!
 //       see: http://www.gotw.ca/publications/N1211.pdf
 
-typedef boost::mpl::vector<uint8_t, int16_t, int32_t, int64_t, double, long double, string,
-                           vector<uint8_t>, vector<int16_t>, vector<int32_t>, vector<int64_t>,
-                           vector<double>, vector<long double>, vector<string>,
-                           boost::python::object>
+typedef boost::mpl::vector21<uint8_t, int16_t, int32_t, int64_t, double, long double, string,
+                             vector<uint8_t>, vector<int16_t>, vector<int32_t>, vector<int64_t>,
+                             vector<double>, vector<long double>, vector<string>,
+                             boost::python::object, float, uint32_t, uint64_t,
+                             vector<float>, vector<uint32_t>, vector<uint64_t>>
     value_types;
 
+// Note: float and the unsigned types were introduced after the original list,
+//       and are appended to it so that the position of each type (which is
+//       used as its type code in the binary format) remains stable. The
+//       numbered form is used since the list exceeds the default arity of
+//       mpl::vector<>.
+
 extern const char* type_names[]; // respective type names (defined in
                                  // graph_properties.cc)
 
 // scalar types: types contained in value_types which are scalar
-typedef boost::mpl::vector<uint8_t, int16_t, int32_t, int64_t, double, long double>
+typedef boost::mpl::vector<uint8_t, int16_t, int32_t, int64_t, uint32_t, uint64_t,
+                           float, double, long double>
     scalar_types;
 
 // integer_types: scalar types which are integer
-typedef boost::mpl::vector<uint8_t, int16_t, int32_t, int64_t> integer_types;
+typedef boost::mpl::vector<uint8_t, int16_t, int32_t, int64_t, uint32_t, uint64_t>
+    integer_types;
 
 // floating_types: scalar types which are floating point
-typedef boost::mpl::vector<double, long double> floating_types;
+typedef boost::mpl::vector<float, double, long double> floating_types;
 
 struct make_vector
 {
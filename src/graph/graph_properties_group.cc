@@ -21,6 +21,7 @@
 #include "graph_selectors.hh"
 
 #include "graph_properties_group.hh"
+#include "numpy_bind.hh"
 
 #include <boost/python/extract.hpp>
 
@@ -45,14 +46,87 @@ void group_vector_property(GraphInterface& g, boost::any vector_prop,
 {
     if (edge)
         run_action<graph_tool::detail::always_directed_never_reversed>()
-            (g, bind(do_group_vector_property<boost::mpl::true_,boost::mpl::true_>(),
+            (g, std::bind(do_group_vector_property<boost::mpl::true_,boost::mpl::true_>(),
                      placeholders::_1, placeholders::_2, placeholders::_3, pos),
              edge_vector_properties(), edge_properties())
             (vector_prop, prop);
     else
         run_action<graph_tool::detail::always_directed_never_reversed>()
-            (g, bind(do_group_vector_property<boost::mpl::true_,boost::mpl::false_>(),
+            (g, std::bind(do_group_vector_property<boost::mpl::true_,boost::mpl::false_>(),
                      placeholders::_1, placeholders::_2, placeholders::_3, pos),
              vertex_vector_properties(), vertex_properties())
             (vector_prop, prop);
 }
+
+// Set the entries at the given positions of a scalar vector-valued property
+// map from a two-dimensional array, laid out as the one returned by
+// ungroup_vector_array(). The array is converted to the value type of the
+// map if necessary.
+template <class IndexMap>
+struct do_group_vector_array
+{
+    template <class Value>
+    void operator()(Value, boost::any& aprop, python::object& oa,
+                    const vector<int64_t>& idx, const vector<size_t>& pos,
+                    bool& found) const
+    {
+        typedef typename property_map_type::apply<vector<Value>,
+                                                  IndexMap>::type pmap_t;
+        pmap_t* pmap = any_cast<pmap_t>(&aprop);
+        if (pmap == nullptr)
+            return;
+        found = true;
+
+        int val_type = boost::mpl::at<numpy_types, Value>::type::value;
+        python::object ca(python::handle<>
+                          (PyArray_FROMANY(oa.ptr(), val_type, 2, 2,
+                                           NPY_ARRAY_ALIGNED)));
+        auto a = get_array<Value, 2>(ca);
+        if (a.shape()[0] != pos.size() || a.shape()[1] != idx.size())
+            throw ValueException("array must have shape (" +
+                                 lexical_cast<string>(pos.size()) + ", " +
+                                 lexical_cast<string>(idx.size()) + ")");
+        if (idx.empty() || pos.empty())
+            return;
+
+        size_t max_pos = *max_element(pos.begin(), pos.end());
+        pmap->reserve(idx.back() + 1);
+        auto& vals = pmap->get_storage();
+
+        int i, N = idx.size();
+        #pragma omp parallel for default(shared) private(i) \
+            schedule(runtime) if (N > 100)
+        for (i = 0; i < N; ++i)
+        {
+            auto& v = vals[idx[i]];
+            if (v.size() <= max_pos)
+                v.resize(max_pos + 1);
+            for (size_t j = 0; j < pos.size(); ++j)
+                v[pos[j]] = a[j][i];
+        }
+    }
+};
+
+void group_vector_array(GraphInterface& gi, boost::any vector_prop,
+                        python::object oa, python::object opos, bool edge)
+{
+    vector<size_t> pos;
+    for (int i = 0; i < python::len(opos); ++i)
+        pos.push_back(python::extract<size_t>(opos[i]));
+
+    bool found = false;
+    if (edge)
+        mpl::for_each<scalar_types>
+            (std::bind(do_group_vector_array<GraphInterface::edge_index_map_t>(),
+                       std::placeholders::_1, std::ref(vector_prop),
+                       std::ref(oa), std::cref(gi.GetActiveEdges()),
+                       std::cref(pos), std::ref(found)));
+    else
+        mpl::for_each<scalar_types>
+            (std::bind(do_group_vector_array<GraphInterface::vertex_index_map_t>(),
+                       std::placeholders::_1, std::ref(vector_prop),
+                       std::ref(oa), std::cref(gi.GetActiveVertices()),
+                       std::cref(pos), std::ref(found)));
+    if (!found)
+        throw ValueException("property map must have a scalar vector value type");
+}
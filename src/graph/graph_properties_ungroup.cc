@@ -21,6 +21,7 @@
 #include "graph_selectors.hh"
 
 #include "graph_properties_group.hh"
+#include "numpy_bind.hh"
 
 #include <boost/python/extract.hpp>
 
@@ -44,14 +45,79 @@ void ungroup_vector_property(GraphInterface& g, boost::any vector_prop,
 {
     if (edge)
         run_action<graph_tool::detail::always_directed_never_reversed>()
-            (g, bind(do_group_vector_property<boost::mpl::false_,boost::mpl::true_>(),
+            (g, std::bind(do_group_vector_property<boost::mpl::false_,boost::mpl::true_>(),
                      placeholders::_1, placeholders::_2, placeholders::_3, pos),
              edge_vector_properties(), writable_edge_properties())
             (vector_prop, prop);
     else
         run_action<graph_tool::detail::always_directed_never_reversed>()
-            (g, bind(do_group_vector_property<boost::mpl::false_,boost::mpl::false_>(),
+            (g, std::bind(do_group_vector_property<boost::mpl::false_,boost::mpl::false_>(),
                      placeholders::_1, placeholders::_2, placeholders::_3, pos),
              vertex_vector_properties(), writable_vertex_properties())
             (vector_prop, prop);
 }
+
+// Copy the entries at the given positions of a scalar vector-valued property
+// map into a two-dimensional array, with one row per position and one column
+// per active vertex or edge (in index order), in a single pass over the
+// values. Missing entries are set to zero.
+template <class IndexMap>
+struct do_ungroup_vector_array
+{
+    template <class Value>
+    void operator()(Value, boost::any& aprop, const vector<int64_t>& idx,
+                    const vector<size_t>& pos, python::object& ret,
+                    bool& found) const
+    {
+        typedef typename property_map_type::apply<vector<Value>,
+                                                  IndexMap>::type pmap_t;
+        pmap_t* pmap = any_cast<pmap_t>(&aprop);
+        if (pmap == nullptr)
+            return;
+        found = true;
+        auto& vals = pmap->get_storage();
+
+        boost::multi_array<Value, 2> a(boost::extents[pos.size()][idx.size()]);
+        int i, N = idx.size();
+        #pragma omp parallel for default(shared) private(i) \
+            schedule(runtime) if (N > 100)
+        for (i = 0; i < N; ++i)
+        {
+            size_t k = idx[i];
+            for (size_t j = 0; j < pos.size(); ++j)
+            {
+                if (k < vals.size() && pos[j] < vals[k].size())
+                    a[j][i] = vals[k][pos[j]];
+                else
+                    a[j][i] = Value();
+            }
+        }
+        ret = wrap_multi_array_owned<Value, 2>(a);
+    }
+};
+
+python::object ungroup_vector_array(GraphInterface& gi, boost::any vector_prop,
+                                    python::object opos, bool edge)
+{
+    vector<size_t> pos;
+    for (int i = 0; i < python::len(opos); ++i)
+        pos.push_back(python::extract<size_t>(opos[i]));
+
+    python::object ret;
+    bool found = false;
+    if (edge)
+        mpl::for_each<scalar_types>
+            (std::bind(do_ungroup_vector_array<GraphInterface::edge_index_map_t>(),
+                       std::placeholders::_1, std::ref(vector_prop),
+                       std::cref(gi.GetActiveEdges()), std::cref(pos),
+                       std::ref(ret), std::ref(found)));
+    else
+        mpl::for_each<scalar_types>
+            (std::bind(do_ungroup_vector_array<GraphInterface::vertex_index_map_t>(),
+                       std::placeholders::_1, std::ref(vector_prop),
+                       std::cref(gi.GetActiveVertices()), std::cref(pos),
+                       std::ref(ret), std::ref(found)));
+    if (!found)
+        throw ValueException("property map must have a scalar vector value type");
+    return ret;
+}
@@ -154,8 +154,10 @@ void remove_vertex(GraphInterface& gi, const python::object& oindex, bool fast)
     }
     else
     {
+        vector<bool> deleted(num_vertices(g), false);
         for (auto v : index)
-            remove_vertex(vertex(v, g), g);
+            deleted[v] = true;
+        remove_vertices(deleted, g);
     }
 }
 
@@ -388,18 +390,48 @@ struct add_edge_list
                 if (edge_list.shape()[1] < 2)
                     throw GraphException("Second dimension in edge list must be of size (at least) two");
 
-                for (size_t i = 0; i < edge_list.shape()[0]; ++i)
-                {
-                    size_t s = edge_list[i][0];
-                    size_t t = edge_list[i][1];
-                    while (s >= num_vertices(g) || t >= num_vertices(g))
-                        add_vertex(g);
-                    add_edge(vertex(s, g), vertex(t, g), g);
-                }
+                insert_edges(g, edge_list);
                 found = true;
             }
             catch (invalid_numpy_conversion& e) {}
         }
+
+        template <class Graph, class EdgeList>
+        void insert_edges(Graph& g, EdgeList& edge_list) const
+        {
+            for (size_t i = 0; i < edge_list.shape()[0]; ++i)
+            {
+                size_t s = edge_list[i][0];
+                size_t t = edge_list[i][1];
+                while (s >= num_vertices(g) || t >= num_vertices(g))
+                    add_vertex(g);
+                add_edge(vertex(s, g), vertex(t, g), g);
+            }
+        }
+
+        // unfiltered and unreversed graphs get the whole list at once
+        template <class Vertex, class EdgeList>
+        void insert_edges(adj_list<Vertex>& g, EdgeList& edge_list) const
+        {
+            vector<pair<Vertex, Vertex>> es(edge_list.shape()[0]);
+            size_t N = num_vertices(g);
+            for (size_t i = 0; i < es.size(); ++i)
+            {
+                es[i].first = edge_list[i][0];
+                es[i].second = edge_list[i][1];
+                N = max(N, size_t(max(es[i].first, es[i].second)) + 1);
+            }
+            while (num_vertices(g) < N)
+                add_vertex(g);
+            add_edges(es, g);
+        }
+
+        template <class Vertex, class EdgeList>
+        void insert_edges(UndirectedAdaptor<adj_list<Vertex>>& g,
+                          EdgeList& edge_list) const
+        {
+            insert_edges(g.OriginalGraph(), edge_list);
+        }
     };
 };
 
@@ -414,6 +446,17 @@ void do_add_edge_list(GraphInterface& gi, python::object aedge_list)
         throw GraphException("Invalid type for edge list; must be two-dimensional with a scalar type");
 }
 
+python::object get_active_vertices(GraphInterface& gi)
+{
+    vector<int64_t> vs = gi.GetActiveVertices();
+    return wrap_vector_owned(vs);
+}
+
+python::object get_active_edges(GraphInterface& gi)
+{
+    vector<int64_t> es = gi.GetActiveEdges();
+    return wrap_vector_owned(es);
+}
 
 } // namespace graph_tool
 
@@ -468,6 +511,9 @@ void export_python_interface()
     def("remove_vertex", graph_tool::remove_vertex);
     def("remove_edge", graph_tool::remove_edge);
     def("add_edge_list", graph_tool::do_add_edge_list);
+    def("get_active_vertices", graph_tool::get_active_vertices);
+    def("get_active_edges", graph_tool::get_active_edges);
+    def("touch_filter_values", &GraphInterface::TouchFilterValues);
 
     def("get_vertex_index", get_vertex_index);
     def("get_edge_index", do_get_edge_index);
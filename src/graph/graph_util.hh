@@ -397,6 +397,10 @@ string lexical_cast<string,uint8_t>(const uint8_t& val);
 template <>
 uint8_t lexical_cast<uint8_t,string>(const string& val);
 template <>
+string lexical_cast<string,float>(const float& val);
+template <>
+float lexical_cast<float,string>(const string& val);
+template <>
 string lexical_cast<string,double>(const double& val);
 template <>
 double lexical_cast<double,string>(const string& val);
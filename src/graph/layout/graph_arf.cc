@@ -37,7 +37,7 @@ void arf_layout(GraphInterface& g, boost::any pos, boost::any weight, double d,
 
     if(weight.empty())
         weight = weight_map_t(1);
-    run_action<graph_tool::detail::never_directed>()
+    run_action_nogil<graph_tool::detail::never_directed>()
         (g, std::bind(get_arf_layout(), placeholders::_1, placeholders::_2,
                       placeholders::_3, a, d, dt, epsilon, max_iter, dim),
          vertex_floating_vector_properties(), edge_props_t())(pos, weight);
@@ -20,6 +20,7 @@
 
 #include <limits>
 #include <iostream>
+#include <boost/multi_array.hpp>
 
 namespace graph_tool
 {
@@ -35,7 +36,10 @@ struct get_arf_layout
     {
         typedef typename property_traits<PosMap>::value_type::value_type pos_t;
 
+        // the positions are kept in a contiguous N x dim array during the
+        // layout, and copied back to the property map at the end
         int i, N = num_vertices(g);
+        boost::multi_array<pos_t, 2> fpos(boost::extents[N][dim]);
         #pragma omp parallel for default(shared) private(i)
         for (i = 0; i < N; ++i)
         {
@@ -44,6 +48,8 @@ struct get_arf_layout
             if (v == graph_traits<Graph>::null_vertex())
                 continue;
             pos[v].resize(dim);
+            for (size_t j = 0; j < dim; ++j)
+                fpos[i][j] = pos[v][j];
         }
 
         pos_t delta = epsilon + 1;
@@ -71,7 +77,7 @@ struct get_arf_layout
                     pos_t diff = 0;
                     for (size_t j = 0; j < dim; ++j)
                     {
-                        pos_t dx = pos[*w][j] - pos[v][j];
+                        pos_t dx = fpos[*w][j] - fpos[v][j];
                         diff += dx*dx;
                         delta_pos[j] += dx;
                     }
@@ -81,7 +87,7 @@ struct get_arf_layout
                     pos_t m = r/diff;
                     for (size_t j = 0; j < dim; ++j)
                     {
-                        pos_t dx = pos[*w][j] - pos[v][j];
+                        pos_t dx = fpos[*w][j] - fpos[v][j];
                         delta_pos[j] -= m*dx;
                     }
                 }
@@ -96,7 +102,7 @@ struct get_arf_layout
                     pos_t m = a*get(weight, *e) - 1;
                     for (size_t j = 0; j < dim; ++j)
                     {
-                        pos_t dx = pos[u][j] - pos[v][j];
+                        pos_t dx = fpos[u][j] - fpos[v][j];
                         delta_pos[j] += m*dx;
                     }
                 }
@@ -104,12 +110,23 @@ struct get_arf_layout
                 #pragma omp critical
                 for (size_t j = 0; j < dim; ++j)
                 {
-                    pos[v][j] += dt*delta_pos[j];
+                    fpos[v][j] += dt*delta_pos[j];
                     delta += abs(delta_pos[j]);
                 }
             }
             n_iter++;
         }
+
+        #pragma omp parallel for default(shared) private(i)
+        for (i = 0; i < N; ++i)
+        {
+            typename graph_traits<Graph>::vertex_descriptor v =
+                vertex(i, g);
+            if (v == graph_traits<Graph>::null_vertex())
+                continue;
+            for (size_t j = 0; j < dim; ++j)
+                pos[v][j] = fpos[i][j];
+        }
     }
 };
 
@@ -173,7 +173,7 @@ void fruchterman_reingold_layout(GraphInterface& g, boost::any pos,
     if(weight.empty())
         weight = weight_map_t(1.0);
     if (square)
-        run_action<graph_tool::detail::never_directed>()
+        run_action_nogil<graph_tool::detail::never_directed>()
             (g,
              std::bind(get_layout<square_topology<> >(), placeholders::_1,
                        placeholders::_2, placeholders::_3, make_pair(a, r), scale,
@@ -181,7 +181,7 @@ void fruchterman_reingold_layout(GraphInterface& g, boost::any pos,
              vertex_floating_vector_properties(), edge_props_t())
             (pos, weight);
     else
-        run_action<graph_tool::detail::never_directed>()
+        run_action_nogil<graph_tool::detail::never_directed>()
             (g,
              std::bind(get_layout<circle_topology<> >(), placeholders::_1,
                        placeholders::_2, placeholders::_3, make_pair(a, r),
@@ -20,6 +20,7 @@
 
 #include <limits>
 #include <iostream>
+#include <array>
 
 #ifndef __clang__
 #include <ext/numeric>
@@ -42,7 +43,7 @@ class QuadTree
 {
 public:
     QuadTree(const Pos& ll, const Pos& ur, int max_level)
-        :_ll(ll), _ur(ur), _cm(2, 0), _count(0),
+        :_ll(ll), _ur(ur), _cm(), _count(0),
          _max_level(max_level)
     {
         _w = sqrt(power(_ur[0] - _ll[0], 2) +
@@ -207,13 +208,20 @@ struct get_sfdp_layout
                     VertexWeightMap vweight, EdgeWeightMap eweight, PinMap pin,
                     GroupMap group, bool verbose, RNG& rng) const
     {
-        typedef typename property_traits<PosMap>::value_type pos_t;
         typedef typename property_traits<PosMap>::value_type::value_type val_t;
 
+        // the positions are kept in contiguous fixed-size storage during the
+        // layout, and copied back to the property map at the end
+        typedef std::array<val_t, 2> pos_t;
+        unchecked_vector_property_map<pos_t, VertexIndex>
+            fpos(vertex_index, num_vertices(g));
+
         typedef typename property_traits<VertexWeightMap>::value_type vweight_t;
 
-        pos_t ll(2, numeric_limits<val_t>::max()),
-            ur(2, -numeric_limits<val_t>::max());
+        pos_t ll = {{numeric_limits<val_t>::max(),
+                     numeric_limits<val_t>::max()}},
+            ur = {{-numeric_limits<val_t>::max(),
+                   -numeric_limits<val_t>::max()}};
 
         vector<pos_t> group_cm;
         vector<vweight_t> group_size;
@@ -229,6 +237,8 @@ struct get_sfdp_layout
             if (pin[v] == 0)
                 vertices.push_back(v);
             pos[v].resize(2, 0);
+            for (size_t j = 0; j < 2; ++j)
+                fpos[v][j] = pos[v][j];
             size_t s = group[v];
 
             if (s >= group_cm.size())
@@ -236,14 +246,13 @@ struct get_sfdp_layout
                 group_cm.resize(s + 1);
                 group_size.resize(s + 1, 0);
             }
-            group_cm[s].resize(2, 0);
             group_size[s] += get(vweight, v);
 
             for (size_t j = 0; j < 2; ++j)
             {
-                ll[j] = min(pos[v][j], ll[j]);
-                ur[j] = max(pos[v][j], ur[j]);
-                group_cm[s][j] += pos[v][j] * get(vweight, v);
+                ll[j] = min(fpos[v][j], ll[j]);
+                ur[j] = max(fpos[v][j], ur[j]);
+                group_cm[s][j] += fpos[v][j] * get(vweight, v);
             }
             HN++;
         }
@@ -252,7 +261,6 @@ struct get_sfdp_layout
         {
             if (group_size[s] == 0)
                 continue;
-            group_cm[s].resize(2, 0);
             for (size_t j = 0; j < 2; ++j)
                 group_cm[s][j] /= group_size[s];
         }
@@ -269,8 +277,10 @@ struct get_sfdp_layout
             E0 = E;
             E = 0;
 
-            pos_t nll(2, numeric_limits<val_t>::max()),
-                nur(2, -numeric_limits<val_t>::max());
+            pos_t nll = {{numeric_limits<val_t>::max(),
+                          numeric_limits<val_t>::max()}},
+                nur = {{-numeric_limits<val_t>::max(),
+                        -numeric_limits<val_t>::max()}};
 
             QuadTree<pos_t, vweight_t> qt(ll, ur, max_level);
             for (i = 0; i < N; ++i)
@@ -279,7 +289,7 @@ struct get_sfdp_layout
                     vertex(i, g);
                 if (v == graph_traits<Graph>::null_vertex())
                     continue;
-                qt.put_pos(pos[v], vweight[v]);
+                qt.put_pos(fpos[v], vweight[v]);
             }
 
             std::shuffle(vertices.begin(), vertices.end(), rng);
@@ -293,7 +303,8 @@ struct get_sfdp_layout
             {
                 auto v = vertex(vertices[i], g);
 
-                pos_t diff(2, 0), pos_u(2, 0), ftot(2, 0), cm(2, 0);
+                pos_t diff = {{0, 0}}, pos_u = {{0, 0}}, ftot = {{0, 0}},
+                    cm = {{0, 0}};
 
                 // global repulsive forces
                 Q.push_back(std::ref(qt));
@@ -307,11 +318,11 @@ struct get_sfdp_layout
                         auto& dleafs = q.get_dense_leafs();
                         for(size_t j = 0; j < dleafs.size(); ++j)
                         {
-                            val_t d = get_diff(get<0>(dleafs[j]), pos[v],
+                            val_t d = get_diff(get<0>(dleafs[j]), fpos[v],
                                                diff);
                             if (d == 0)
                                 continue;
-                            val_t f = f_r(C, K, p, pos[v], get<0>(dleafs[j]));
+                            val_t f = f_r(C, K, p, fpos[v], get<0>(dleafs[j]));
                             f *= get<1>(dleafs[j]) * get(vweight, v);
                             for (size_t l = 0; l < 2; ++l)
                                 ftot[l] += f * diff[l];
@@ -321,7 +332,7 @@ struct get_sfdp_layout
                     {
                         double w = q.get_w();
                         q.get_cm(cm);
-                        double d = get_diff(cm, pos[v], diff);
+                        double d = get_diff(cm, fpos[v], diff);
                         if (w > theta * d)
                         {
                             for(size_t j = 0; j < 4; ++j)
@@ -335,7 +346,7 @@ struct get_sfdp_layout
                         {
                             if (d > 0)
                             {
-                                val_t f = f_r(C, K, p, cm, pos[v]);
+                                val_t f = f_r(C, K, p, cm, fpos[v]);
                                 f *= q.get_count() * get(vweight, v);
                                 for (size_t l = 0; l < 2; ++l)
                                     ftot[l] += f * diff[l];
@@ -352,10 +363,10 @@ struct get_sfdp_layout
                         continue;
                     #pragma omp critical
                     {
-                        pos_u = pos[u];
+                        pos_u = fpos[u];
                     }
-                    get_diff(pos_u, pos[v], diff);
-                    val_t f = f_a(K, pos_u, pos[v]);
+                    get_diff(pos_u, fpos[v], diff);
+                    val_t f = f_a(K, pos_u, fpos[v]);
                     f *= get(eweight, e) * get(vweight, u) * get(vweight, v);
                     for (size_t l = 0; l < 2; ++l)
                         ftot[l] += f * diff[l];
@@ -370,11 +381,11 @@ struct get_sfdp_layout
                             continue;
                         if (s == size_t(group[v]))
                             continue;
-                        val_t d = get_diff(group_cm[s], pos[v], diff);
+                        val_t d = get_diff(group_cm[s], fpos[v], diff);
                         if (d == 0)
                             continue;
                         double Kp = K * power(HN, 2);
-                        val_t f = f_a(Kp, group_cm[s], pos[v]) * gamma * \
+                        val_t f = f_a(Kp, group_cm[s], fpos[v]) * gamma * \
                             group_size[s] * get(vweight, v);
                         for (size_t l = 0; l < 2; ++l)
                             ftot[l] += f * diff[l];
@@ -390,10 +401,10 @@ struct get_sfdp_layout
                             continue;
                         if (s == size_t(group[v]))
                             continue;
-                        val_t d = get_diff(group_cm[s], pos[v], diff);
+                        val_t d = get_diff(group_cm[s], fpos[v], diff);
                         if (d == 0)
                             continue;
-                        val_t f = f_r(C, K, p, cm, pos[v]);
+                        val_t f = f_r(C, K, p, cm, fpos[v]);
                         f *= group_size[s] * get(vweight, v) * abs(gamma);
                         for (size_t l = 0; l < 2; ++l)
                             ftot[l] += f * diff[l];
@@ -403,11 +414,11 @@ struct get_sfdp_layout
                 // intra-group attractive forces
                 if (group_size[group[v]] > 1 && mu > 0)
                 {
-                    val_t d = get_diff(group_cm[group[v]], pos[v], diff);
+                    val_t d = get_diff(group_cm[group[v]], fpos[v], diff);
                     if (d > 0)
                     {
                         double Kp = K * pow(double(group_size[group[v]]), mu_p);
-                        val_t f = f_a(Kp, group_cm[group[v]], pos[v]) * mu * \
+                        val_t f = f_a(Kp, group_cm[group[v]], fpos[v]) * mu * \
                             group_size[group[v]] * get(vweight, v);
                         for (size_t l = 0; l < 2; ++l)
                             ftot[l] += f * diff[l];
@@ -421,15 +432,15 @@ struct get_sfdp_layout
                     for (size_t l = 0; l < 2; ++l)
                     {
                         group_cm[group[v]][l] *= group_size[group[v]];
-                        group_cm[group[v]][l] -= pos[v][l];
+                        group_cm[group[v]][l] -= fpos[v][l];
 
                         ftot[l] *= step;
-                        pos[v][l] += ftot[l];
+                        fpos[v][l] += ftot[l];
 
-                        nll[l] = min(pos[v][l], nll[l]);
-                        nur[l] = max(pos[v][l], nur[l]);
+                        nll[l] = min(fpos[v][l], nll[l]);
+                        nur[l] = max(fpos[v][l], nur[l]);
 
-                        group_cm[group[v]][l] += pos[v][l];
+                        group_cm[group[v]][l] += fpos[v][l];
                         group_cm[group[v]][l] /= group_size[group[v]];
                     }
                 }
@@ -467,6 +478,16 @@ struct get_sfdp_layout
                 }
             }
         }
+
+        N = vertices.size();
+        #pragma omp parallel for default(shared) private(i) \
+            schedule(runtime) if (N > 100)
+        for (i = 0; i < N; ++i)
+        {
+            auto v = vertex(vertices[i], g);
+            for (size_t j = 0; j < 2; ++j)
+                pos[v][j] = fpos[v][j];
+        }
     }
 };
 
@@ -23,6 +23,13 @@
 #include <boost/mpl/empty.hpp>
 #include <boost/any.hpp>
 
+#include <vector>
+#include <tuple>
+#include <typeindex>
+#include <unordered_map>
+#include <mutex>
+#include <array>
+
 namespace boost
 {
 namespace mpl
@@ -186,6 +193,131 @@ struct selected_types
     std::vector<any> _args;
 };
 
+
+// nested_for_each() goes through every combination of the type ranges, and
+// select_types() tests each one of them against the arguments. For long type
+// ranges this is expensive compared to the action itself when it runs on small
+// inputs. The function below has the same effect as
+//
+//    nested_for_each<TRS...>(select_types(a, found, args...));
+//
+// but the instantiation of the action matching the types of the arguments is
+// kept in a cache, and subsequent calls with the same argument types invoke it
+// directly. It returns whether a matching instantiation was found.
+
+template <std::size_t... Idx>
+struct index_list {};
+
+template <std::size_t N, std::size_t... Idx>
+struct make_index_list: make_index_list<N - 1, N - 1, Idx...> {};
+
+template <std::size_t... Idx>
+struct make_index_list<0, Idx...>
+{
+    typedef index_list<Idx...> type;
+};
+
+template <class Action>
+struct resolve_types
+{
+    typedef void (*invoke_t)(const Action&, std::vector<any>&);
+
+    resolve_types(const std::vector<any>& args, invoke_t& invoke)
+        : _args(args), _invoke(invoke) {}
+
+    template <class... Ts>
+    void operator()(Ts&&...) const
+    {
+        typedef typename make_index_list<sizeof...(Ts)>::type idx_t;
+        if (match<typename std::decay<Ts>::type...>(idx_t()))
+            _invoke = &invoke<typename std::decay<Ts>::type...>;
+    }
+
+    template <class... Ts, std::size_t... Idx>
+    bool match(index_list<Idx...>) const
+    {
+        for (bool m : {(_args[Idx].type() == typeid(Ts))...})
+            if (!m)
+                return false;
+        return true;
+    }
+
+    template <class... Ts>
+    static void invoke(const Action& a, std::vector<any>& args)
+    {
+        typedef typename make_index_list<sizeof...(Ts)>::type idx_t;
+        invoke_imp<Ts...>(a, args, idx_t());
+    }
+
+    template <class... Ts, std::size_t... Idx>
+    static void invoke_imp(const Action& a, std::vector<any>& args,
+                           index_list<Idx...>)
+    {
+        a(*any_cast<Ts>(&args[Idx])...);
+    }
+
+    const std::vector<any>& _args;
+    invoke_t& _invoke;
+};
+
+template <std::size_t N>
+struct dispatch_key
+{
+    template <std::size_t... Idx>
+    dispatch_key(const std::vector<any>& args, index_list<Idx...>)
+        : _types{{std::type_index(args[Idx].type())...}} {}
+
+    bool operator==(const dispatch_key& other) const
+    {
+        return _types == other._types;
+    }
+
+    struct hash
+    {
+        std::size_t operator()(const dispatch_key& key) const
+        {
+            std::size_t h = 0;
+            for (auto& t : key._types)
+                h ^= t.hash_code() + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    std::array<std::type_index, N> _types;
+};
+
+template <class... TRS, class Action, class... Args>
+bool cached_nested_dispatch(Action a, Args&&... args)
+{
+    typedef typename resolve_types<Action>::invoke_t invoke_t;
+    typedef dispatch_key<sizeof...(Args)> key_t;
+    static std::unordered_map<key_t, invoke_t, typename key_t::hash> cache;
+    static std::mutex cache_mutex;
+
+    std::vector<any> as = {args...};
+    key_t key(as, typename make_index_list<sizeof...(Args)>::type());
+
+    invoke_t invoke = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto iter = cache.find(key);
+        if (iter != cache.end())
+            invoke = iter->second;
+    }
+
+    if (invoke == nullptr)
+    {
+        nested_for_each<TRS...>(resolve_types<Action>(as, invoke));
+        if (invoke == nullptr)
+            return false;
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        cache[key] = invoke;
+    }
+
+    invoke(a, as);
+    return true;
+}
+
 } // mpl namespace
 } // boost namespace
 
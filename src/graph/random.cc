@@ -22,3 +22,11 @@ rng_t get_rng(size_t seed)
     std::seed_seq seq{seed, seed + 1, seed + 2, seed + 3, seed + 4};
     return rng_t(seq);
 }
+
+rng_t split_rng(rng_t& rng)
+{
+    std::array<int, rng_t::state_size> seed_data;
+    std::generate_n(seed_data.data(), seed_data.size(), std::ref(rng));
+    std::seed_seq seq(std::begin(seed_data), std::end(seed_data));
+    return rng_t(seq);
+}
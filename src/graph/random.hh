@@ -18,10 +18,139 @@
 #ifndef RANDOM_HH
 #define RANDOM_HH
 
+#include "config.h"
+
 #include <random>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <functional>
+
+#ifdef USING_OPENMP
+#include <omp.h>
+#endif
 
 typedef std::mt19937 rng_t;
 
 rng_t get_rng(size_t seed);
 
+// new generator seeded from the state of an existing one, so that independent
+// streams derived from a seeded generator are themselves reproducible
+rng_t split_rng(rng_t& rng);
+
+// This holds one random number generator per OpenMP thread, so that parallel
+// loops need not serialise on a single one. The master thread uses the
+// original generator, and the others are seeded from it.
+template <class RNG>
+class parallel_rng
+{
+public:
+    parallel_rng(RNG& rng): _rng(rng)
+    {
+        size_t num_threads = 1;
+#ifdef USING_OPENMP
+        num_threads = omp_get_max_threads();
+#endif
+        for (size_t i = 1; i < num_threads; ++i)
+        {
+            std::array<int, RNG::state_size> seed_data;
+            std::generate_n(seed_data.data(), seed_data.size(), std::ref(rng));
+            std::seed_seq seq(std::begin(seed_data), std::end(seed_data));
+            _rngs.emplace_back(seq);
+        }
+    }
+
+    RNG& get()
+    {
+        size_t tid = 0;
+#ifdef USING_OPENMP
+        tid = omp_get_thread_num();
+#endif
+        if (tid == 0 || tid > _rngs.size())
+            return _rng;
+        return _rngs[tid - 1];
+    }
+
+private:
+    RNG& _rng;
+    std::vector<RNG> _rngs;
+};
+
+// Uniform random permutation of the elements of "in", written to "out", using
+// all available threads. Each element is sent to a random bucket, and the
+// buckets are then shuffled independently and concatenated, which yields a
+// uniform permutation.
+template <class Value, class RNG>
+void parallel_shuffle(std::vector<Value>& in, std::vector<Value>& out,
+                      RNG& rng)
+{
+    size_t M = in.size();
+    out.resize(M);
+
+    size_t num_threads = 1;
+#ifdef USING_OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+
+    if (num_threads == 1 || M < 100000)
+    {
+        std::copy(in.begin(), in.end(), out.begin());
+        std::shuffle(out.begin(), out.end(), rng);
+        return;
+    }
+
+    parallel_rng<RNG> prng(rng);
+
+    size_t B = 8 * num_threads;
+    std::vector<size_t> count(num_threads * B, 0); // (bucket, thread) pairs
+    std::vector<size_t> bpos(B + 1, 0);
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+        size_t tid = 0, nt = 1;
+#ifdef USING_OPENMP
+        tid = omp_get_thread_num();
+        nt = omp_get_num_threads();
+#endif
+        size_t lo = (M * tid) / nt;
+        size_t hi = (M * (tid + 1)) / nt;
+
+        RNG& trng = prng.get();
+        RNG replay = trng;
+        std::uniform_int_distribution<size_t> rbucket(0, B - 1);
+
+        for (size_t i = lo; i < hi; ++i)
+            count[rbucket(trng) * nt + tid]++;
+
+        #pragma omp barrier
+
+        #pragma omp single
+        {
+            size_t pos = 0;
+            for (size_t b = 0; b < B; ++b)
+            {
+                bpos[b] = pos;
+                for (size_t t = 0; t < nt; ++t)
+                {
+                    size_t c = count[b * nt + t];
+                    count[b * nt + t] = pos;
+                    pos += c;
+                }
+            }
+            bpos[B] = pos;
+        }
+
+        // draw the same buckets again, now scattering the elements
+        for (size_t i = lo; i < hi; ++i)
+            out[count[rbucket(replay) * nt + tid]++] = in[i];
+
+        #pragma omp barrier
+
+        #pragma omp for schedule(dynamic)
+        for (size_t b = 0; b < B; ++b)
+            std::shuffle(out.begin() + bpos[b], out.begin() + bpos[b + 1],
+                         prng.get());
+    }
+}
+
 #endif
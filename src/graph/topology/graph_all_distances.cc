@@ -71,7 +71,7 @@ void get_all_dists(GraphInterface& gi, boost::any dist_map, boost::any weight,
     if (weight.empty())
         weight = boost::any(cweight_map_t(1));
 
-    run_action<>()
+    run_action_nogil<>()
         (gi, std::bind(do_all_pairs_search(), placeholders::_1,
                        gi.GetVertexIndex(), placeholders::_2, placeholders::_3,
                        dense),
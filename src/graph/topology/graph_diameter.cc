@@ -151,13 +151,13 @@ python::object get_diam(GraphInterface& gi, size_t source, boost::any weight)
     long double max_dist;
     if (weight.empty())
     {
-        run_action<>()
+        run_action_nogil<>()
             (gi, std::bind(do_bfs_search(), placeholders::_1, source, gi.GetVertexIndex(),
                            std::ref(target), std::ref(max_dist)))();
     }
     else
     {
-        run_action<>()
+        run_action_nogil<>()
             (gi, std::bind(do_djk_search(), placeholders::_1, source, gi.GetVertexIndex(),
                            placeholders::_2, std::ref(target), std::ref(max_dist)),
              edge_scalar_properties())(weight);
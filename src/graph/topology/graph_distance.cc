@@ -180,7 +180,7 @@ void get_dists(GraphInterface& gi, size_t source, int tgt, boost::any dist_map,
 
     if (weight.empty())
     {
-        run_action<>()
+        run_action_nogil<>()
             (gi, std::bind(do_bfs_search(), placeholders::_1, source, target, gi.GetVertexIndex(),
                            placeholders::_2, pmap.get_unchecked(num_vertices(gi.GetGraph())),
                            max_dist),
@@ -189,7 +189,7 @@ void get_dists(GraphInterface& gi, size_t source, int tgt, boost::any dist_map,
     }
     else
     {
-        run_action<>()
+        run_action_nogil<>()
             (gi, std::bind(do_djk_search(), placeholders::_1, source, target, gi.GetVertexIndex(),
                            placeholders::_2, pmap.get_unchecked(num_vertices(gi.GetGraph())),
                            placeholders::_3, max_dist),
@@ -101,7 +101,7 @@ bool check_isomorphism(GraphInterface& gi1, GraphInterface& gi2,
         return false;
     if (gi1.GetDirected())
     {
-        run_action<graph_tool::detail::always_directed>()
+        run_action_nogil<graph_tool::detail::always_directed>()
             (gi1, std::bind(check_iso(),
                             placeholders::_1, placeholders::_2,
                             inv_map1, inv_map2, max_inv, iso_map,
@@ -112,7 +112,7 @@ bool check_isomorphism(GraphInterface& gi1, GraphInterface& gi2,
     }
     else
     {
-        run_action<graph_tool::detail::never_directed>()
+        run_action_nogil<graph_tool::detail::never_directed>()
             (gi1, std::bind(check_iso(),
                             placeholders::_1, placeholders::_2,
                             inv_map1, inv_map2, max_inv, iso_map,
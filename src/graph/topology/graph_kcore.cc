@@ -31,11 +31,11 @@ using namespace graph_tool;
 void do_kcore_decomposition(GraphInterface& gi, boost::any prop,
                             GraphInterface::deg_t deg)
 {
-    run_action<>()(gi, std::bind(kcore_decomposition(), placeholders::_1,
-                                 gi.GetVertexIndex(), placeholders::_2,
-                                 placeholders::_3),
-                   writable_vertex_scalar_properties(),
-                   degree_selectors())(prop, degree_selector(deg));
+    run_action_nogil<>()(gi, std::bind(kcore_decomposition(), placeholders::_1,
+                                       gi.GetVertexIndex(), placeholders::_2,
+                                       placeholders::_3),
+                         writable_vertex_scalar_properties(),
+                         degree_selectors())(prop, degree_selector(deg));
 }
 
 void export_kcore()
@@ -57,7 +57,7 @@ size_t similarity_fast(GraphInterface& gi1, GraphInterface& gi2, boost::any labe
                        boost::any label2)
 {
     size_t s = 0;
-    run_action<graph_tool::detail::all_graph_views, boost::mpl::true_>()
+    run_action_nogil<graph_tool::detail::all_graph_views, boost::mpl::true_>()
         (gi1, std::bind(get_similarity_fast(), placeholders::_1, placeholders::_2,
                         placeholders::_3, label2, std::ref(s)),
          get_pointers::apply<graph_tool::detail::all_graph_views>::type(),
@@ -122,6 +122,7 @@ from inspect import ismethod
 __all__ = ["Graph", "GraphView", "Vertex", "Edge", "Vector_bool",
            "Vector_int16_t", "Vector_int32_t", "Vector_int64_t",
            "Vector_double", "Vector_long_double", "Vector_string",
+           "Vector_float", "Vector_uint32_t", "Vector_uint64_t",
            "Vector_size_t", "value_types", "load_graph", "PropertyMap",
            "group_vector_property", "ungroup_vector_property",
            "infect_vertex_property", "edge_endpoint_property",
@@ -183,9 +184,13 @@ def _type_alias(type_name):
              "int": "int32_t",
              "long": "int64_t",
              "long long": "int64_t",
-             "unsigned long": "int64_t",
-             "object": "python::object",
-             "float": "double"}
+             "unsigned int": "uint32_t",
+             "unsigned long": "uint64_t",
+             "size_t": "uint64_t",
+             "float": "double",
+             "float32": "float32_t",
+             "single": "float32_t",
+             "object": "python::object"}
     if type_name in value_types():
         return type_name
     if type_name in alias:
@@ -208,7 +213,7 @@ def _python_type(type_name):
         return int
     if type_name == "bool":
         return bool
-    if "double" in type_name:
+    if "double" in type_name or "float" in type_name:
         return float
     if "string" in type_name:
         return str
@@ -217,7 +222,11 @@ def _python_type(type_name):
 
 def _gt_type(obj):
     t = type(obj)
-    if t is numpy.longlong or t is numpy.uint64:
+    if t is numpy.uint64:
+        return "uint64_t"
+    if t is numpy.uint32:
+        return "uint32_t"
+    if t is numpy.longlong:
         return "long long"
     if issubclass(t, numpy.int16):
         return "short"
@@ -225,6 +234,8 @@ def _gt_type(obj):
         return "int"
     if t is numpy.float128:
         return "long double"
+    if t is numpy.float32:
+        return "float32_t"
     if t is float or issubclass(t, numpy.float):
         return "double"
     if t is str:
@@ -256,6 +267,7 @@ def show_config():
     print("install prefix:", info.install_prefix)
     print("python dir:", info.python_dir)
     print("graph filtering:", libcore.graph_filtering_enabled())
+    print("slim dispatch:", libcore.slim_dispatch_enabled())
     print("openmp:", libcore.openmp_enabled())
     print("uname:", " ".join(os.uname()))
 
@@ -387,6 +399,9 @@ class PropertyMap(object):
         ``int16_t``                 ``short``
         ``int32_t``                 ``int``
         ``int64_t``                 ``long``, ``long long``
+        ``uint32_t``                ``unsigned int``
+        ``uint64_t``                ``unsigned long``, ``size_t``
+        ``float32_t``               ``float32``, ``single``
         ``double``                  ``float``
         ``long double``
         ``string``
@@ -394,6 +409,9 @@ class PropertyMap(object):
         ``vector<int16_t>``         ``short``
         ``vector<int32_t>``         ``vector<int>``
         ``vector<int64_t>``         ``vector<long>``, ``vector<long long>``
+        ``vector<uint32_t>``        ``vector<unsigned int>``
+        ``vector<uint64_t>``        ``vector<unsigned long>``, ``vector<size_t>``
+        ``vector<float32_t>``       ``vector<float32>``, ``vector<single>``
         ``vector<double>``          ``vector<float>``
         ``vector<long double>``
         ``vector<string>``
@@ -412,6 +430,8 @@ class PropertyMap(object):
         except NameError:
             pass  # ignore if GraphView is yet undefined
         self.__key_type = key_type
+        self.__maybe_filter = (key_type != "g" and
+                               pmap.value_type() == "bool")
         self.__register_map()
 
     def __key_trans(self, key):
@@ -439,6 +459,7 @@ class PropertyMap(object):
 
     def __setitem__(self, k, v):
         key = self.__key_trans(k)
+        self.__touch_filter()
         try:
             self.__map[key] = v
         except TypeError:
@@ -516,10 +537,19 @@ class PropertyMap(object):
             raise ValueError("Cannot get array for value type: " + self.value_type())
         return PropertyArray(a, prop_map=self)
 
+    def __touch_filter(self):
+        # boolean maps may be used as filters, and the graphs cache the lists
+        # of filtered vertices and edges, so they are told that the values may
+        # change
+        if self.__maybe_filter:
+            libcore.touch_filter_values(self.__key_type == "e")
+
     def _get_data(self):
         g = self.get_graph()
         if g is None:
             raise ValueError("Cannot get array for an orphaned property map")
+        # the returned array may be written to
+        self.__touch_filter()
         if self.__key_type == 'v':
             n = g._Graph__graph.GetNumberOfVertices(False)
         elif self.__key_type == 'e':
@@ -549,41 +579,34 @@ class PropertyMap(object):
         if g is None:
             return None
         a = self.get_array()
-        filt = [None]
+        idx = None
         if self.__key_type == 'v':
-            filt = g.get_vertex_filter()
-        elif self.__key_type == 'e':
-            filt = g.get_edge_filter()
             if g.get_vertex_filter()[0] is not None:
-                filt = (g.new_edge_property("bool"), filt[1])
-                u = GraphView(g, directed=True, skip_properties=True)
-                libcore.mark_edges(u._Graph__graph, _prop("e", u, filt[0]))
-                if filt[1]:
-                    filt[0].a = 1 - filt[0].a
-            elif g._get_max_edge_index() != g.num_edges():
-                filt = (g.new_edge_property("bool"), False)
-                u = GraphView(g, directed=True, skip_properties=True)
-                libcore.mark_edges(u._Graph__graph, _prop("e", u, filt[0]))
+                idx = libcore.get_active_vertices(g._Graph__graph)
+        elif self.__key_type == 'e':
+            if (g.get_edge_filter()[0] is not None or
+                g.get_vertex_filter()[0] is not None or
+                g._get_max_edge_index() != g.num_edges()):
+                idx = libcore.get_active_edges(g._Graph__graph)
         if get:
             if a is None:
                 return a
-            if filt[0] is None:
+            if idx is None:
                 return a
-            return a[filt[0].a == (not filt[1])]
+            return a[idx]
         else:
             if a is None:
                 return
-            if filt[0] is None:
+            if idx is None:
                 try:
                     a[:] = v
                 except ValueError:
                     a[:] = v[:len(a)]
             else:
-                m = filt[0].a == (not filt[1])
                 try:
-                    a[m] = v
+                    a[idx] = v
                 except ValueError:
-                    a[m] = v[:len(m)][m]
+                    a[idx] = v[idx]
 
     fa = property(__get_set_f_array,
                   lambda self, v: self.__get_set_f_array(v, False),
@@ -638,7 +661,12 @@ class PropertyMap(object):
         r"""Return a two-dimensional array with a copy of the entries of the
         vector-valued property map. The parameter ``pos`` must be a sequence of
         integers which specifies the indexes of the property values which will
-        be used. """
+        be used. The array has one row for each value of ``pos``, and one
+        column for each vertex or edge which is not filtered out, in index
+        order.
+
+        For scalar vector types the array is filled in a single pass, and
+        entries missing from shorter vectors are set to zero."""
 
         if self.key_type() == "g":
             raise ValueError("Cannot create multidimensional array for graph property maps.")
@@ -667,17 +695,20 @@ class PropertyMap(object):
                 a = a[0]
             return numpy.array(a)
 
-        try:
+        if "vector" not in self.value_type():
             return numpy.array(self.fa)
-        except ValueError:
-            p = ungroup_vector_property(self, pos)
-            return numpy.array([x.a for x in p])
+
+        g = self.get_graph()
+        return libcore.ungroup_vector_array(g._Graph__graph,
+                                            _prop(self.key_type(), g, self),
+                                            list(pos), self.key_type() == "e")
 
     def set_2d_array(self, a, pos=None):
         r"""Set the entries of the vector-valued property map from a
         two-dimensional array ``a``. If given, the parameter ``pos`` must be a
         sequence of integers which specifies the indexes of the property values
-        which will be set."""
+        which will be set. The array must have the same layout as the one
+        returned by :meth:`~PropertyMap.get_2d_array`."""
 
         if self.key_type() == "g":
             raise ValueError("Cannot set multidimensional array for graph property maps.")
@@ -698,6 +729,15 @@ class PropertyMap(object):
             return
 
         val = self.value_type()[7:-1]
+        if val != "string":
+            g = self.get_graph()
+            if pos is None:
+                pos = range(len(a))
+            libcore.group_vector_array(g._Graph__graph,
+                                       _prop(self.key_type(), g, self),
+                                       a, list(pos), self.key_type() == "e")
+            return
+
         ps = []
         for i in range(a.shape[0]):
             ps.append(self.get_graph().new_property(self.key_type(), val))
@@ -774,6 +814,7 @@ class PropertyMap(object):
         self.__g = pmap.__g
         self.__base_g = pmap.__base_g
         self.__key_type = key_type
+        self.__maybe_filter = pmap.__maybe_filter
         self.__register_map()
 
 
@@ -784,10 +825,10 @@ def _check_prop_writable(prop, name=None):
 
 
 def _check_prop_scalar(prop, name=None, floating=False):
-    scalars = ["bool", "int32_t", "int64_t", "unsigned long",
-               "double", "long double"]
+    scalars = ["bool", "int32_t", "int64_t", "uint32_t", "uint64_t",
+               "float32_t", "double", "long double"]
     if floating:
-        scalars = ["double", "long double"]
+        scalars = ["float32_t", "double", "long double"]
 
     if prop.value_type() not in scalars:
         raise ValueError("property map%s is not of scalar%s type." %\
@@ -796,12 +837,12 @@ def _check_prop_scalar(prop, name=None, floating=False):
 
 
 def _check_prop_vector(prop, name=None, scalar=True, floating=False):
-    scalars = ["bool", "int32_t", "int64_t", "unsigned long",
-               "double", "long double"]
+    scalars = ["bool", "int32_t", "int64_t", "uint32_t", "uint64_t",
+               "float32_t", "double", "long double"]
     if not scalar:
         scalars += ["string"]
     if floating:
-        scalars = ["double", "long double"]
+        scalars = ["float32_t", "double", "long double"]
     vals = ["vector<%s>" % v for v in scalars]
     if prop.value_type() not in vals:
         raise ValueError("property map%s is not of vector%s type." %\
@@ -1181,7 +1222,8 @@ class PropertyDict(dict):
 
 from .libgraph_tool_core import Vertex, EdgeBase, Vector_bool, Vector_int16_t, \
     Vector_int32_t, Vector_int64_t, Vector_double, Vector_long_double, \
-    Vector_string, Vector_size_t, new_vertex_property, new_edge_property, \
+    Vector_string, Vector_float, Vector_uint32_t, Vector_size_t, \
+    new_vertex_property, new_edge_property, \
     new_graph_property
 
 
@@ -1215,6 +1257,7 @@ class Graph(object):
     def __init__(self, g=None, directed=True, prune=False, vorder=None):
         self.__properties = {}
         self.__known_properties = {}
+        self.__materialized = None
         self.__filter_state = {"reversed": False,
                                "edge_filter": (None, False),
                                "vertex_filter": (None, False),
@@ -1495,7 +1538,8 @@ class Graph(object):
         .. note::
 
            If the option ``fast == False`` is given, this operation is
-           :math:`O(N + E)` (this is the default). Otherwise it is
+           :math:`O(N + E)` (this is the default), even if many vertices are
+           removed at once. Otherwise it is
            :math:`O(k + k_{\text{last}})`, where :math:`k` is the (total)
            degree of the vertex being deleted, and :math:`k_{\text{last}}` is
            the (total) degree of the vertex with the largest index.
@@ -1519,7 +1563,8 @@ class Graph(object):
 
            Alternatively (and preferably), a list (or iterable) may be passed
            directly as the ``vertex`` parameter, and the above is performed
-           internally (in C++).
+           internally (in C++). If ``fast == False``, all the vertices are
+           then removed in a single pass over the graph.
 
         .. warning::
 
@@ -1816,6 +1861,12 @@ class Graph(object):
         """
         self.__graph.ReIndexEdges()
 
+    def shrink_to_fit(self):
+        """Release the memory reserved for the edge lists which is not currently
+        in use. This is useful after the graph has been built by adding edges
+        one at a time, which may leave substantial slack capacity behind."""
+        self.__graph.ShrinkToFit()
+
     # Property map creation
 
     def new_property(self, key_type, value_type, vals=None):
@@ -1901,6 +1952,7 @@ class Graph(object):
         g = GraphView(u, directed=True, reversed=u.is_reversed(),
                       skip_properties=True)
 
+        tgt._PropertyMap__touch_filter()
         if src.key_type() == "v":
             self.__graph.CopyVertexProperty(g.__graph, _prop("v", g, src),
                                             _prop("v", self, tgt))
@@ -2195,8 +2247,8 @@ class Graph(object):
 
         If the option ``in_place == True`` is given, the algorithm will remove
         the filtered vertices and re-index all property maps which are tied with
-        the graph. This is a slow operation which has an :math:`O(N^2)`
-        complexity.
+        the graph. This is done in a single pass over the graph, with an
+        :math:`O(N + E)` complexity.
 
         If ``in_place == False``, the graph and its vertex and edge property
         maps are temporarily copied to a new unfiltered graph, which will
@@ -2242,10 +2294,52 @@ class Graph(object):
 
     def purge_edges(self):
         """Remove all edges of the graph which are currently being filtered out,
-        and return it to the unfiltered state. This operation is not reversible."""
+        and return it to the unfiltered state. This operation is not reversible,
+        and has an :math:`O(N + E)` complexity."""
         self.__graph.PurgeEdges()
         self.set_edge_filter(None)
 
+    def materialize(self):
+        r"""Return a tuple ``(u, vmap, emap)``, where ``u`` is a new unfiltered
+        :class:`~graph_tool.Graph` which contains only the vertices and edges of
+        this graph which are not currently filtered out, and ``vmap`` and
+        ``emap`` are vertex and edge property maps of ``u`` with the indexes of
+        the corresponding vertices and edges of this graph.
+
+        Algorithms run on ``u`` avoid the overhead of skipping filtered
+        vertices and edges. Property maps can be translated to ``u`` by
+        indexing, e.g. ``w_u.a = w.a[emap.a]``, and back again with
+        ``w.a[emap.a] = w_u.a``. No internal property maps are copied.
+
+        The result is cached, and is returned again by subsequent calls, as
+        long as the filters, their values, the directionality and reversal of
+        this graph, and the vertices and edges of both graphs remain
+        unchanged. Building it is :math:`O(N + E)`, and checking the cache is
+        :math:`O(N + E)` only if there are filters, with a much smaller
+        constant.
+        """
+        vfilt, vinv = self.get_vertex_filter()
+        efilt, einv = self.get_edge_filter()
+        key = (self.__graph.GetStamp(), self.is_directed(), self.is_reversed(),
+               None if vfilt is None else (vinv, hash(vfilt.a.tobytes())),
+               None if efilt is None else (einv, hash(efilt.a.tobytes())))
+        if self.__materialized is not None:
+            ckey, u, vmap, emap, ustamp = self.__materialized
+            if ckey == key and u._Graph__graph.GetStamp() == ustamp:
+                return u, vmap, emap
+
+        gv = GraphView(self, skip_properties=True)
+        gv.vertex_properties["vindex"] = gv.vertex_index.copy("int64_t")
+        gv.edge_properties["eindex"] = gv.edge_index.copy("int64_t")
+        u = Graph(gv, prune=True)
+        vmap = u.vertex_properties["vindex"]
+        emap = u.edge_properties["eindex"]
+        del u.vertex_properties["vindex"]
+        del u.edge_properties["eindex"]
+
+        self.__materialized = (key, u, vmap, emap, u._Graph__graph.GetStamp())
+        return u, vmap, emap
+
     def get_filter_state(self):
         """Return a copy of the filter state of the graph."""
         self.__filter_state["directed"] = self.is_directed()
@@ -2631,8 +2725,11 @@ def _get_array_view(self):
 def _set_array_view(self, v):
     self.get_array()[:] = v
 
+Vector_uint64_t = Vector_size_t
+
 vector_types = [Vector_bool, Vector_int16_t, Vector_int32_t, Vector_int64_t,
-                Vector_double, Vector_long_double]
+                Vector_uint32_t, Vector_uint64_t, Vector_float, Vector_double,
+                Vector_long_double]
 for vt in vector_types:
     vt.a = property(_get_array_view, _set_array_view,
                     doc=r"""Shortcut to the `get_array` method as an attribute.""")
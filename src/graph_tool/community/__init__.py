@@ -82,6 +82,7 @@ Summary
    :nosignatures:
 
    community_structure
+   modularity_multilevel
    modularity
 
 
@@ -124,11 +125,13 @@ __all__ = ["minimize_blockmodel_dl",
            "get_hierarchy_tree",
            "get_block_edge_gradient",
            "community_structure",
+           "modularity_multilevel",
            "modularity"]
 
 from . blockmodel import minimize_blockmodel_dl, BlockState, mcmc_sweep, \
     multilevel_minimize, model_entropy, get_max_B, get_akc, condensation_graph, \
     collect_edge_marginals, collect_vertex_marginals, bethe_entropy, mf_entropy, MinimizeState
+from . blockmodel import pmap, reverse_map, continuous_map
 
 from . overlap_blockmodel import OverlapBlockState, get_block_edge_gradient
 
@@ -312,6 +315,113 @@ def community_structure(g, n_iter, n_spins, gamma=1.0, corr="erdos",
     return spins
 
 
+def modularity_multilevel(g, weight=None, gamma=1.0, max_levels=None,
+                          max_passes=100):
+    r"""Obtain a hierarchy of community partitions via multilevel modularity
+    maximization.
+
+    .. warning::
+
+       **The use of this function is discouraged.** It suffers from the same
+       problems as any other method based on modularity maximization (see
+       :func:`~graph_tool.community.community_structure`). It is meant only as
+       a fast way to obtain baseline partitions for very large graphs.
+
+    Parameters
+    ----------
+    g : :class:`~graph_tool.Graph`
+        Graph to be used.
+    weight : :class:`~graph_tool.PropertyMap` (optional, default: None)
+        Edge property map with the optional edge weights.
+    gamma : float (optional, default: 1.0)
+        The resolution parameter :math:`\gamma`.
+    max_levels : int (optional, default: None)
+        Maximum number of hierarchy levels. If not given, the coarse-graining
+        proceeds until the modularity can no longer be improved.
+    max_passes : int (optional, default: 100)
+        Maximum number of passes over all vertices in the local moving phase at
+        each level.
+
+    Returns
+    -------
+    bs : list of :class:`~graph_tool.PropertyMap`
+        Vertex property maps with the community partition of the vertices of
+        ``g`` at each level, from the finest to the coarsest.
+
+    See Also
+    --------
+    community_structure: obtain the community structure
+    modularity: calculate the network modularity
+    condensation_graph: Network of communities, or blocks
+
+    Notes
+    -----
+
+    This implements the multilevel heuristic of [blondel-fast-2008]_, which
+    maximizes the generalized modularity
+
+    .. math::
+
+          Q = \frac{1}{2E} \sum_r e_{rr}- \gamma\frac{e_r^2}{2E},
+
+    where the quantities are defined as in
+    :func:`~graph_tool.community.modularity`. At each level, vertices are
+    repeatedly moved to the neighbouring community which increases :math:`Q`
+    the most, and then each community is collapsed into a single vertex via
+    :func:`~graph_tool.community.condensation_graph`, and the procedure is
+    repeated on the condensed graph.
+
+    The complexity of each level is :math:`O(E)` per pass.
+
+    If enabled during compilation, the local moving phase runs in parallel.
+
+    Examples
+    --------
+    >>> from numpy.random import seed
+    >>> seed(42)
+    >>> g = gt.load_graph("community.xml")
+    >>> bs = gt.modularity_multilevel(g)
+    >>> Q = gt.modularity(g, bs[-1])
+
+    References
+    ----------
+    .. [blondel-fast-2008] Vincent D. Blondel, Jean-Loup Guillaume, Renaud
+       Lambiotte, and Etienne Lefebvre, "Fast unfolding of communities in large
+       networks", J. Stat. Mech. P10008 (2008),
+       :doi:`10.1088/1742-5468/2008/10/P10008`, :arxiv:`0803.0476`
+    """
+
+    ug = GraphView(g, directed=False)
+
+    # map of the original vertices to the vertices of the condensed graph
+    vmap = g.vertex_index.copy("int32_t")
+
+    bs = []
+    cg = ug
+    cweight = weight
+    while max_levels is None or len(bs) < max_levels:
+        b = cg.vertex_index.copy("int32_t")
+        nmoves = libgraph_tool_community.modularity_local_moves(cg._Graph__graph,
+                                                                _prop("e", cg, cweight),
+                                                                _prop("v", cg, b),
+                                                                gamma, max_passes,
+                                                                _get_rng())
+        if nmoves == 0:
+            break
+
+        continuous_map(b)
+        pmap(vmap, b)
+        bs.append(vmap.copy())
+
+        cg, cb, vcount, cweight = condensation_graph(cg, b, eweight=cweight,
+                                                     self_loops=True)[:4]
+
+        rmap = cg.new_vertex_property("int32_t")
+        reverse_map(cb, rmap)
+        pmap(vmap, rmap)
+    return bs
+
+
 def modularity(g, prop, weight=None):
     r"""
     Calculate Newman's modularity.
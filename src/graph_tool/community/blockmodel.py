@@ -981,6 +981,10 @@ def mcmc_sweep(state, beta=1., c=1., dl=False, dense=False, multigraph=False,
         if merge_map is None:
             merge_map = state.g.vertex_index.copy("int")
 
+    rng = kwargs.get("rng", None)
+    if rng is None:
+        rng = _get_rng()
+
     if dl and not state.partition_stats.is_enabled():
         if state.overlap:
             state._OverlapBlockState__init_partition_stats(empty=False)
@@ -1023,7 +1027,7 @@ def mcmc_sweep(state, beta=1., c=1., dl=False, dense=False, multigraph=False,
                                                  nmerges, nmerge_sweeps,
                                                  _prop("v", state.g, merge_map),
                                                  state.partition_stats,
-                                                 verbose, _get_rng())
+                                                 verbose, rng)
         else:
             dS, nmoves = libcommunity.move_sweep_overlap(state.g._Graph__graph,
                                                          state.bg._Graph__graph,
@@ -1054,7 +1058,7 @@ def mcmc_sweep(state, beta=1., c=1., dl=False, dense=False, multigraph=False,
                                                          _prop("v", state.g, merge_map),
                                                          state.overlap_stats,
                                                          state.partition_stats,
-                                                         verbose, _get_rng())
+                                                         verbose, rng)
 
     finally:
         if random_move:
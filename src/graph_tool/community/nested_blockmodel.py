@@ -33,6 +33,7 @@ import scipy.special
 from collections import defaultdict
 import copy
 import heapq
+import threading
 
 from . blockmodel import *
 from . blockmodel import __test__
@@ -470,7 +471,8 @@ class NestedBlockState(object):
             print("l: %d, N: %d, B: %d" % (l, state.N, state.B))
 
 
-def nested_mcmc_sweep(state, beta=1., c=1., dl=False, sequential=True, verbose=False):
+def nested_mcmc_sweep(state, beta=1., c=1., dl=False, sequential=True,
+                      parallel_levels=False, verbose=False):
     r"""Performs a Markov chain Monte Carlo sweep on all levels of the hierarchy.
 
     Parameters
@@ -492,6 +494,13 @@ def nested_mcmc_sweep(state, beta=1., c=1., dl=False, sequential=True, verbose=F
         random order. Otherwise a total of `N` moves attempts are made, where
         `N` is the number of vertices, where each vertex can be selected with
         equal probability.
+    parallel_levels : ``bool`` (optional, default: ``False``)
+        If ``True``, the levels are swept concurrently in separate threads, in
+        two alternating phases: first all the even levels, then all the odd
+        ones. Since the moves at level :math:`l` only modify the block graph
+        used by level :math:`l+1`, and are constrained by the partition at
+        level :math:`l+1`, levels with the same parity do not interfere with
+        each other.
     verbose : ``bool`` (optional, default: ``False``)
         If ``True``, verbose information is displayed.
 
@@ -511,7 +520,8 @@ def nested_mcmc_sweep(state, beta=1., c=1., dl=False, sequential=True, verbose=F
 
     This algorithm has a worse-case complexity of :math:`O(E \times L)`, where
     :math:`E` is the number of edges in the network, and :math:`L` is the depth
-    of the hierarchy.
+    of the hierarchy. If ``parallel_levels == True``, the wall time of the
+    sweep approaches the time taken by the bottom level alone.
 
     Examples
     --------
@@ -542,10 +552,8 @@ def nested_mcmc_sweep(state, beta=1., c=1., dl=False, sequential=True, verbose=F
        :arxiv:`1409.3059`.
     """
 
-    rets = []
-    for l, bstate in enumerate(state.levels):
-        if verbose:
-            print("Level:", l, "N:", bstate.N, "B:", bstate.B)
+    def get_clabel(l):
+        bstate = state.levels[l]
 
         # constraint partitions not to invalidate upper layers
         if l < len(state.levels) - 1:
@@ -557,17 +565,61 @@ def nested_mcmc_sweep(state, beta=1., c=1., dl=False, sequential=True, verbose=F
         cclabel = state._NestedBlockState__propagate_clabel(l)
         cclabel.a += clabel.a * (cclabel.a.max() + 1)
         continuous_map(cclabel)
+        return cclabel
 
-        bstate.clabel = cclabel
-
+    def sweep_level(l, rng=None):
+        bstate = state.levels[l]
         ret = mcmc_sweep(bstate, beta=beta, c=c, dl=dl,
                          dense = l > 0 and state.deg_corr != "full",
                          multigraph = l > 0,
-                         sequential=sequential, verbose=verbose)
-
+                         sequential=sequential, verbose=verbose, rng=rng)
         bstate.clabel.a = 0
+        return ret
 
-        rets.append(ret)
+    L = len(state.levels)
+    rets = [None] * L
+
+    if not parallel_levels:
+        for l, bstate in enumerate(state.levels):
+            if verbose:
+                print("Level:", l, "N:", bstate.N, "B:", bstate.B)
+            bstate.clabel = get_clabel(l)
+            rets[l] = sweep_level(l)
+        return rets
+
+    for parity in [0, 1]:
+        levels = list(range(parity, L, 2))
+
+        # the constraint labels depend on the partitions of the neighbouring
+        # levels, so they are all computed before any level is touched
+        for l in levels:
+            bstate = state.levels[l]
+            if verbose:
+                print("Level:", l, "N:", bstate.N, "B:", bstate.B)
+            bstate.clabel = get_clabel(l)
+
+        # each level gets its own random number generator, split off from the
+        # global one in a deterministic order, so that seed_rng() still makes
+        # the sweeps reproducible
+        rngs = [libcore.split_rng(_get_rng()) for l in levels]
+
+        errors = []
+        def run(l, rng):
+            try:
+                rets[l] = sweep_level(l, rng)
+            except Exception as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=run, args=(l, rng))
+                   for l, rng in zip(levels[1:], rngs[1:])]
+        for t in threads:
+            t.start()
+        if len(levels) > 0:
+            run(levels[0], rngs[0])
+        for t in threads:
+            t.join()
+        if len(errors) > 0:
+            raise errors[0]
     return rets
 
 def replace_level(l, state, min_B=None, max_B=None, max_b=None, nsweeps=10,
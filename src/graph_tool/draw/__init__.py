@@ -134,11 +134,10 @@ def random_layout(g, shape=None, pos=None, dim=2):
         pos = g.new_vertex_property("vector<double>")
     _check_prop_vector(pos, name="pos")
 
-    pos = ungroup_vector_property(pos, list(range(0, dim)))
-
     if shape == None:
         shape = [sqrt(g.num_vertices())] * dim
 
+    P = numpy.zeros((dim, g.num_vertices()))
     for i in range(dim):
         if hasattr(shape[i], "__len__"):
             if len(shape[i]) != 2:
@@ -147,12 +146,9 @@ def random_layout(g, shape=None, pos=None, dim=2):
         else:
             r = [min(shape[i], 0), max(shape[i], 0)]
         d = r[1] - r[0]
+        P[i, :] = numpy.random.random(P.shape[1]) * d + r[0]
 
-        # deal with filtering
-        p = pos[i].ma
-        p[:] = numpy.random.random(len(p)) * d + r[0]
-
-    pos = group_vector_property(pos)
+    pos.set_2d_array(P, list(range(dim)))
     return pos
 
 
@@ -75,8 +75,7 @@ import copy
 import io
 from collections import defaultdict
 
-from .. import GraphView, PropertyMap, ungroup_vector_property,\
-     group_vector_property, _prop, _check_prop_vector
+from .. import GraphView, PropertyMap, _prop, _check_prop_vector
 
 from .. stats import label_parallel_edges, label_self_loops
 
@@ -301,8 +300,9 @@ def _convert(attr, val, cmap):
         if isinstance(val, PropertyMap):
             if val.value_type() in ["vector<double>", "vector<long double>"]:
                 return val
-            if val.value_type() in ["int32_t", "int64_t", "double",
-                                    "long double", "unsigned long", "bool"]:
+            if val.value_type() in ["int32_t", "int64_t", "uint32_t",
+                                    "uint64_t", "float32_t", "double",
+                                    "long double", "bool"]:
                 try:
                     vrange = [val.fa.min(), val.fa.max()]
                 except ValueError:
@@ -884,9 +884,9 @@ def graph_draw(g, pos=None, vprops=None, eprops=None, vorder=None, eorder=None,
         ctr.artists.append(artist)
 
         if fit_view and ax is not None:
-            x, y = ungroup_vector_property(pos, [0, 1])
-            l, r = x.a.min(), x.a.max()
-            b, t = y.a.min(), y.a.max()
+            x, y = pos.get_2d_array([0, 1])
+            l, r = x.min(), x.max()
+            b, t = y.min(), y.max()
             w = r - l
             h = t - b
             ax.set_xlim(l - w * .1, r + w * .1)
@@ -1065,12 +1065,14 @@ def get_bb(g, pos, size, pen_width, size_scale=1, text=None, font_family=None,
            font_size=None, cr=None):
     size = size.fa[:g.num_vertices()] if isinstance(size, PropertyMap) else size
     pen_width = pen_width.fa if isinstance(pen_width, PropertyMap) else pen_width
-    pos_x, pos_y = ungroup_vector_property(pos, [0, 1])
+    if isinstance(pos, PropertyMap):
+        pos = pos.get_2d_array([0, 1])
+    pos_x, pos_y = pos
     if text is not None and text != "":
         if not isinstance(size, PropertyMap):
             uniform = (not isinstance(font_size, PropertyMap) and
                        not isinstance(font_family, PropertyMap))
-            size = np.ones(len(pos_x.fa)) * size
+            size = np.ones(len(pos_x)) * size
         else:
             uniform = False
         for i, v in enumerate(g.vertices()):
@@ -1093,12 +1095,12 @@ def get_bb(g, pos, size, pen_width, size_scale=1, text=None, font_family=None,
     sl = label_self_loops(g)
     slm = sl.a.max() * 0.75
     delta = (size * size_scale * (slm + 1)) / 2 + pen_width * 2
-    x_range = [pos_x.fa.min(), pos_x.fa.max()]
-    y_range = [pos_y.fa.min(), pos_y.fa.max()]
-    x_delta = [x_range[0] - (pos_x.fa - delta).min(),
-               (pos_x.fa + delta).max() - x_range[1]]
-    y_delta = [y_range[0] - (pos_y.fa - delta).min(),
-               (pos_y.fa + delta).max() - y_range[1]]
+    x_range = [pos_x.min(), pos_x.max()]
+    y_range = [pos_y.min(), pos_y.max()]
+    x_delta = [x_range[0] - (pos_x - delta).min(),
+               (pos_x + delta).max() - x_range[1]]
+    y_delta = [y_range[0] - (pos_y - delta).min(),
+               (pos_y + delta).max() - y_range[1]]
     return x_range, y_range, x_delta, y_delta
 
 
@@ -1107,19 +1109,14 @@ def fit_to_view(g, pos, geometry, size, pen_width, M=None, text=None,
     if g.num_vertices() == 0:
         return [0, 0], 1
     if M is not None:
-        pos_x, pos_y = ungroup_vector_property(pos, [0, 1])
-        P = np.zeros((2, len(pos_x.fa)))
-        P[0, :] = pos_x.fa
-        P[1, :] = pos_y.fa
+        P = pos.get_2d_array([0, 1])
         T = np.zeros((2, 2))
         O = np.zeros(2)
         T[0, 0], T[1, 0], T[0, 1], T[1, 1], O[0], O[1] = M
         P = np.dot(T, P)
         P[0] += O[0]
         P[1] += O[1]
-        pos_x.fa = P[0, :]
-        pos_y.fa = P[1, :]
-        pos = group_vector_property([pos_x, pos_y])
+        pos = P
     x_range, y_range, x_delta, y_delta = get_bb(g, pos, size, pen_width,
                                                 1, text, font_family,
                                                 font_size, cr)
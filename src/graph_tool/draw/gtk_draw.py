@@ -20,8 +20,7 @@
 
 from __future__ import division, absolute_import, print_function
 
-from .. import GraphView, PropertyMap, ungroup_vector_property,\
-     group_vector_property, _prop
+from .. import GraphView, PropertyMap, _prop
 from .cairo_draw import *
 from .cairo_draw import _vdefaults, _edefaults
 from .. draw import sfdp_layout, random_layout, _avg_edge_distance, \
@@ -63,9 +62,9 @@ class VertexMatrix(object):
             return boxes
 
     def update(self):
-        pos_x, pos_y = ungroup_vector_property(self.pos, [0, 1])
-        x_range = [pos_x.fa.min(), pos_x.fa.max()]
-        y_range = [pos_y.fa.min(), pos_y.fa.max()]
+        pos_x, pos_y = self.pos.get_2d_array([0, 1])
+        x_range = [pos_x.min(), pos_x.max()]
+        y_range = [pos_y.min(), pos_y.max()]
         self.m_res = min(x_range[1] - x_range[0],
                          y_range[1] - y_range[0]) / np.sqrt(self.g.num_vertices())
         self.m_res *= np.sqrt(10)
@@ -345,7 +344,7 @@ class GraphWidget(Gtk.DrawingArea):
         """Perform one step of the layout algorithm."""
         if self.layout_callback_id is None or self.g.num_vertices() == 0:
             return False
-        pos_temp = ungroup_vector_property(self.pos, [0, 1])
+        pos_temp = self.pos.get_2d_array([0, 1])
         sfdp_layout(self.g, K=self.layout_K,
                     max_iter=5, pos=self.pos,
                     pin=self.selected,
@@ -356,9 +355,9 @@ class GraphWidget(Gtk.DrawingArea):
             self.vertex_matrix.update()
         self.regenerate_surface(lazy=False)
         self.queue_draw()
-        ps = ungroup_vector_property(self.pos, [0, 1])
-        delta = np.sqrt((pos_temp[0].fa - ps[0].fa) ** 2 +
-                        (pos_temp[1].fa - ps[1].fa) ** 2).mean()
+        ps = self.pos.get_2d_array([0, 1])
+        delta = np.sqrt((pos_temp[0] - ps[0]) ** 2 +
+                        (pos_temp[1] - ps[1]) ** 2).mean()
 
         if self.layout_user_callback is not None:
             self.layout_user_callback(self.g, self.picked, self.pos, self.vprops,
@@ -29,6 +29,8 @@ Summary
    :nosignatures:
 
    random_graph
+   configuration_graph
+   generate_sbm
    random_rewire
    predecessor_tree
    line_graph
@@ -55,7 +57,8 @@ import inspect
 import types
 import sys, numpy, numpy.random
 
-__all__ = ["random_graph", "random_rewire", "predecessor_tree", "line_graph",
+__all__ = ["random_graph", "configuration_graph", "generate_sbm",
+           "random_rewire", "predecessor_tree", "line_graph",
            "graph_union", "triangulation", "lattice", "geometric_graph",
            "price_network", "complete_graph", "circular_graph"]
 
@@ -388,7 +391,13 @@ def random_graph(N, deg_sampler, directed=True,
             btype = "vector<int32_t>"
         elif btype in ["long", "int64_t"]:
             btype = "vector<int64_t>"
-        elif btype in ["double"]:
+        elif btype in ["unsigned int", "uint32_t"]:
+            btype = "vector<uint32_t>"
+        elif btype in ["unsigned long", "uint64_t"]:
+            btype = "vector<uint64_t>"
+        elif btype in ["float32_t", "float32", "single"]:
+            btype = "vector<float32_t>"
+        elif btype in ["double", "float"]:
             btype = "vector<double>"
         elif btype in ["long double"]:
             btype = "vector<long double>"
@@ -428,13 +437,195 @@ def random_graph(N, deg_sampler, directed=True,
         return g, bm
 
 
+def configuration_graph(deg, directed=False, self_loops=True,
+                        parallel_edges=True):
+    r"""Generate a random graph with a given degree sequence, according to the
+    configuration model.
+
+    Parameters
+    ----------
+    deg : list or :class:`~numpy.ndarray`
+        Degree sequence. If ``directed == False``, this must be a
+        one-dimensional array with the degree of each vertex. Otherwise it must
+        be a two-dimensional array of shape ``(N, 2)``, where each row contains
+        the in- and out-degree of a vertex, respectively.
+    directed : bool (optional, default: ``False``)
+        Whether the generated graph should be directed.
+    self_loops : bool (optional, default: ``True``)
+        If ``False``, the self-loops obtained are erased.
+    parallel_edges : bool (optional, default: ``True``)
+        If ``False``, the parallel edges obtained are erased, such that only one
+        edge remains between each pair of vertices.
+
+    Returns
+    -------
+    configuration_graph : :class:`~graph_tool.Graph`
+        The generated graph.
+
+    Notes
+    -----
+    Each vertex is given as many "stubs" (half-edges) as its degree, and the
+    stubs are paired uniformly at random [configuration-model]_. This samples
+    uniformly from the ensemble of multigraphs with the given degree sequence
+    (where each configuration of stubs is equally likely), and is done in time
+    :math:`O(V + E)`, using all available threads.
+
+    If self-loops or parallel edges are erased, the degree sequence of the
+    resulting graph will deviate slightly from the one given. If the exact
+    degree sequence must be preserved for simple graphs, use
+    :func:`~graph_tool.generation.random_graph` instead.
+
+    See Also
+    --------
+    random_graph: random graph generation
+    random_rewire: in-place graph shuffling
+
+    Examples
+    --------
+    .. testcode::
+       :hide:
+
+       from numpy.random import poisson, seed
+       seed(42)
+       gt.seed_rng(42)
+
+    >>> deg = poisson(5, 1000)
+    >>> deg[0] += deg.sum() % 2
+    >>> g = gt.configuration_graph(deg)
+    >>> print(g.num_edges() == deg.sum() / 2)
+    True
+
+    References
+    ----------
+    .. [configuration-model] M. E. J. Newman, "The structure and function of
+       complex networks", SIAM Review 45, 167-256 (2003),
+       :doi:`10.1137/S003614450342480`
+
+    """
+
+    deg = numpy.array(deg, dtype="int64")
+    g = Graph(directed=directed)
+    if directed:
+        if len(deg.shape) != 2 or deg.shape[1] != 2:
+            raise ValueError("deg must be an array of shape (N, 2) for directed graphs")
+        in_deg = numpy.array(deg[:, 0])
+        out_deg = numpy.array(deg[:, 1])
+    else:
+        if len(deg.shape) != 1:
+            raise ValueError("deg must be a one-dimensional array for undirected graphs")
+        in_deg = numpy.array([], dtype="int64")
+        out_deg = deg
+    libgraph_tool_generation.configuration(g._Graph__graph, in_deg, out_deg,
+                                           self_loops, parallel_edges,
+                                           _get_rng())
+    return g
+
+def generate_sbm(b, probs, out_degs=None, in_degs=None, directed=False):
+    r"""Generate a random graph by sampling from the Poisson or
+    degree-corrected stochastic block model.
+
+    Parameters
+    ----------
+    b : list or :class:`~numpy.ndarray`
+        Block membership of each vertex, with values in the range
+        :math:`[0, B-1]`.
+    probs : list or :class:`~numpy.ndarray`
+        Matrix of shape ``(B, B)`` with the expected number of edges between
+        each pair of blocks. If ``directed == False``, only the upper triangle
+        is used, and the diagonal entries are twice the expected number of
+        edges inside each block.
+    out_degs : list or :class:`~numpy.ndarray` (optional, default: ``None``)
+        Out-degree propensity of each vertex. If not provided, all vertices in
+        the same block are equivalent.
+    in_degs : list or :class:`~numpy.ndarray` (optional, default: ``None``)
+        In-degree propensity of each vertex, which is only used if ``directed
+        == True``. If not provided, it is the same as ``out_degs``.
+    directed : bool (optional, default: ``False``)
+        Whether the generated graph should be directed.
+
+    Returns
+    -------
+    g : :class:`~graph_tool.Graph`
+        The generated graph.
+
+    Notes
+    -----
+    The number of edges between blocks :math:`r` and :math:`s` is sampled from
+    a Poisson distribution with mean :math:`\lambda_{rs}` given by ``probs``
+    [karrer-stochastic-2011]_, and the endpoints of each edge are chosen
+    inside the blocks with probability proportional to their propensities
+    :math:`\theta_i`. The expected degree of a vertex :math:`i` in block
+    :math:`r` is then
+
+    .. math::
+
+        \left<k_i\right> = \frac{\theta_i}{\sum_{j\in r}\theta_j}\sum_s\lambda_{rs}.
+
+    With a single block, and ``probs = [[sum(k)]]``, this becomes the
+    Chung-Lu model, where the expected degree of each vertex is given by the
+    propensities ``k``.
+
+    The resulting graph may have parallel edges and self-loops. The edges are
+    sampled in parallel with the alias method, in time :math:`O(V + E + B^2)`.
+
+    See Also
+    --------
+    random_graph: random graph generation
+    configuration_graph: configuration model
+
+    Examples
+    --------
+    .. testcode::
+       :hide:
+
+       from numpy.random import randint, seed
+       seed(42)
+       gt.seed_rng(42)
+
+    >>> b = randint(0, 4, 1000)
+    >>> probs = [[4000, 500, 500, 500],
+    ...          [500, 4000, 500, 500],
+    ...          [500, 500, 4000, 500],
+    ...          [500, 500, 500, 4000]]
+    >>> g = gt.generate_sbm(b, probs)
+    >>> print(g.num_vertices())
+    1000
+
+    References
+    ----------
+    .. [karrer-stochastic-2011] Brian Karrer and M. E. J. Newman, "Stochastic
+       blockmodels and community structure in networks", Phys. Rev. E 83,
+       016107 (2011), :doi:`10.1103/PhysRevE.83.016107`
+
+    """
+
+    b = numpy.array(b, dtype="int64")
+    probs = numpy.array(probs, dtype="float")
+    if len(b.shape) != 1:
+        raise ValueError("b must be a one-dimensional array")
+    if len(probs.shape) != 2:
+        raise ValueError("probs must be a two-dimensional array")
+    if out_degs is None:
+        out_degs = numpy.array([], dtype="float")
+    else:
+        out_degs = numpy.array(out_degs, dtype="float")
+    if in_degs is None:
+        in_degs = numpy.array([], dtype="float")
+    else:
+        in_degs = numpy.array(in_degs, dtype="float")
+    g = Graph(directed=directed)
+    libgraph_tool_generation.sbm(g._Graph__graph, b, probs, out_degs, in_degs,
+                                 _get_rng())
+    return g
+
 @_limit_args({"model": ["erdos", "correlated", "uncorrelated",
                         "probabilistic", "blockmodel",
                         "blockmodel-traditional"]})
 def random_rewire(g, model="uncorrelated", n_iter=1, edge_sweep=True,
                   parallel_edges=False, self_loops=False, vertex_corr=None,
                   block_membership=None, alias=True, cache_probs=True,
-                  persist=False, pin=None, ret_fail=False, verbose=False):
+                  persist=False, pin=None, parallel=False, n_samples=1,
+                  callback=None, ret_fail=False, verbose=False):
     r"""
 
     Shuffle the graph in-place, following a variety of possible statistical
@@ -550,6 +741,27 @@ def random_rewire(g, model="uncorrelated", n_iter=1, edge_sweep=True,
         Edge property map which, if provided, specifies which edges are allowed
         to be rewired. Edges for which the property value is ``1`` (or ``True``)
         will be left unmodified in the graph.
+    parallel : bool (optional, default: ``False``)
+        If ``True``, and ``model`` is either ``uncorrelated`` or
+        ``correlated``, each edge sweep will be performed in parallel, using
+        all available threads (if OpenMP is enabled). The edges of each sweep
+        are visited in a different order than in the sequential version, but
+        the moves are accepted or rejected in exactly the same manner, so that
+        the sampled ensemble is the same. This option is ignored for the other
+        models, or if ``edge_sweep == False``.
+    n_samples : int (optional, default: ``1``)
+        Number of successive samples to generate. Each sample is obtained by
+        performing ``n_iter`` further iterations on top of the previous one,
+        reusing the internal state of the rewiring (e.g. the cached
+        probabilities), so that an ensemble of rewired graphs can be obtained
+        without copying the graph or restarting the rewiring. This is only
+        useful together with ``callback``.
+    callback : function (optional, default: ``None``)
+        If given, it will be called as ``callback(g, edges)`` after each
+        sample is obtained, where ``g`` is the (rewired) graph itself, and
+        ``edges`` is an :math:`E\times 2` array with the source and target of
+        each edge, in the same order as given by :meth:`~graph_tool.Graph.edges`.
+        The graph should not be modified by the callback.
     verbose : bool (optional, default: ``False``)
         If ``True``, verbose information is displayed.
 
@@ -819,6 +1031,12 @@ def random_rewire(g, model="uncorrelated", n_iter=1, edge_sweep=True,
     if pin.value_type() != "bool":
         pin = pin.copy(value_type="bool")
 
+    if callback is not None:
+        def sample_callback(k, edges):
+            callback(g, edges.reshape((-1, 2)))
+    else:
+        sample_callback = None
+
     pcount = libgraph_tool_generation.random_rewire(g._Graph__graph, model,
                                                     n_iter, not edge_sweep,
                                                     self_loops, parallel_edges,
@@ -826,7 +1044,8 @@ def random_rewire(g, model="uncorrelated", n_iter=1, edge_sweep=True,
                                                     corr,
                                                     _prop("e", g, pin),
                                                     _prop("v", g, block_membership),
-                                                    cache_probs,
+                                                    cache_probs, parallel,
+                                                    n_samples, sample_callback,
                                                     _get_rng(), verbose)
     return pcount
 
@@ -1421,6 +1640,11 @@ def geometric_graph(points, radius, ranges=None):
     embedded in a N-dimensional euclidean space which are at a distance equal to
     or smaller than a given radius.
 
+    The points are sorted into a grid of cells with sides no smaller than the
+    radius, so that only points in neighbouring cells need to be compared, and
+    the edges are found in parallel. For a given dimension, and uniformly
+    distributed points, this runs in :math:`O(V + E)` time.
+
     See Also
     --------
     triangulation: 2D or 3D triangulation
@@ -1471,8 +1695,7 @@ def geometric_graph(points, radius, ranges=None):
 
     g = Graph(directed=False)
     pos = g.new_vertex_property("vector<double>")
-    if type(points) != numpy.ndarray:
-        points = numpy.array(points)
+    points = numpy.asarray(points, dtype="float")
     if len(points.shape) < 2:
         raise ValueError("points list must be a two-dimensional array!")
     if ranges is not None:
@@ -1491,7 +1714,8 @@ def geometric_graph(points, radius, ranges=None):
     return g, pos
 
 
-def price_network(N, m=1, c=None, gamma=1, directed=True, seed_graph=None):
+def price_network(N, m=1, c=None, gamma=1, directed=True, seed_graph=None,
+                  parallel=False):
     r"""A generalized version of Price's -- or Barabási-Albert if undirected -- preferential attachment network model.
 
     Parameters
@@ -1511,6 +1735,10 @@ def price_network(N, m=1, c=None, gamma=1, directed=True, seed_graph=None):
     seed_graph : :class:`~graph_tool.Graph` (optional, default: ``None``)
         If provided, this graph will be used as the starting point of the
         algorithm.
+    parallel : bool (optional, default: ``False``)
+        If ``True``, the graph is generated in parallel with the copy model
+        (see notes below). This is only possible if ``gamma == 1`` and
+        ``c >= 0``, and if the seed graph is not filtered.
 
     Returns
     -------
@@ -1555,6 +1783,15 @@ def price_network(N, m=1, c=None, gamma=1, directed=True, seed_graph=None):
 
     This algorithm runs in :math:`O(N\log N)` time.
 
+    If ``parallel == True``, the equivalent copy model is used instead: each
+    new edge is attached to a uniformly random vertex with probability
+    proportional to :math:`cN(t)`, or otherwise to the end of a uniformly
+    random older edge (its target, in the directed case). The choices of all
+    edges are made in parallel, and the resulting graphs have the same
+    distribution as above, except that a vertex added at step :math:`t` only
+    sees the edges of the vertices added before it. This runs in
+    :math:`O(N + E)` time, and is intended for very large graphs.
+
     See Also
     --------
     triangulation: 2D or 3D triangulation
@@ -1625,7 +1862,8 @@ def price_network(N, m=1, c=None, gamma=1, directed=True, seed_graph=None):
         N -= g.num_vertices()
     else:
         g = seed_graph
-    libgraph_tool_generation.price(g._Graph__graph, N, gamma, c, m, _get_rng())
+    libgraph_tool_generation.price(g._Graph__graph, N, gamma, c, m, parallel,
+                                   _get_rng())
     return g
 
 class Sampler(libgraph_tool_generation.Sampler):
@@ -1643,3 +1881,7 @@ class DynamicSampler(libgraph_tool_generation.DynamicSampler):
 
     def sample(self):
         return libgraph_tool_generation.DynamicSampler.sample(self, _get_rng())
+
+    def sample_n(self, n):
+        return libgraph_tool_generation.DynamicSampler.sample_n(self, n,
+                                                                _get_rng())